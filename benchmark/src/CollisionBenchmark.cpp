@@ -0,0 +1,334 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "AabbKernel.h"
+#include "Collision.h"
+#include "CollisionWorld.h"
+#include "Composite.h"
+#include "EntityLink.h"
+#include "EntityRegistry.h"
+#include "Map.h"
+#include "MotionSystem.h"
+
+namespace
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    std::vector<std::shared_ptr<CompositeGameObject>> createPopulation(int count, std::mt19937& gen)
+    {
+        sf::FloatRect world = WorldLimits::getBounds();
+        std::uniform_real_distribution<float> xDist(world.left, world.left + world.width);
+        std::uniform_real_distribution<float> yDist(world.top, world.top + world.height);
+
+        std::vector<std::shared_ptr<CompositeGameObject>> gameObjects;
+        gameObjects.reserve(count);
+
+        for (int idx = 0; idx < count; ++idx)
+        {
+            auto gameObject = std::make_shared<CompositeGameObject>("Body" + std::to_string(idx));
+
+            auto square_renderer = std::make_shared<SquareRenderer>(40.0f, sf::Color::Transparent);
+            gameObject->addComponent(square_renderer);
+            square_renderer->setPosition(sf::Vector2f(xDist(gen), yDist(gen)));
+
+            gameObject->addComponent(std::make_shared<Hitbox>(sf::Vector2f(60.0f, 60.0f)));
+            gameObjects.push_back(gameObject);
+        }
+
+        return gameObjects;
+    }
+
+    void jitter(std::vector<std::shared_ptr<CompositeGameObject>>& gameObjects, std::mt19937& gen, size_t movingCount)
+    {
+        std::uniform_real_distribution<float> stepDist(-2.0f, 2.0f);
+
+        for (size_t idx = 0; idx < movingCount && idx < gameObjects.size(); ++idx)
+        {
+            auto transform = gameObjects[idx]->getComponent<Transform>();
+            transform->setPosition(WorldLimits::limits(transform->getPosition() + sf::Vector2f(stepDist(gen), stepDist(gen))));
+        }
+    }
+
+    double bruteForceStep(const std::vector<Hitbox*>& hitboxes, size_t& contacts)
+    {
+        auto start = Clock::now();
+
+        contacts = 0;
+        for (size_t idx = 0; idx < hitboxes.size(); ++idx)
+        {
+            for (size_t jdx = idx + 1; jdx < hitboxes.size(); ++jdx)
+            {
+                if (hitboxes[idx]->checkCollision(hitboxes[jdx]))
+                    ++contacts;
+            }
+        }
+
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    void runPopulation(int count)
+    {
+        std::mt19937 gen(1234);
+        auto gameObjects = createPopulation(count, gen);
+
+        std::vector<Hitbox*> hitboxes;
+        for (auto& gameObject : gameObjects)
+            hitboxes.push_back(gameObject->getComponent<Hitbox>());
+
+        const int steps = count >= 10000 ? 10 : 100;
+
+        Hitbox::resolveCollisions(gameObjects);
+
+        double gridTime = 0.0;
+        size_t gridPairTests = 0;
+        for (int step = 0; step < steps; ++step)
+        {
+            jitter(gameObjects, gen, gameObjects.size());
+
+            auto start = Clock::now();
+            Hitbox::resolveCollisions(gameObjects);
+            gridTime += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            gridPairTests += Hitbox::getPairTestCount();
+        }
+
+        const int bruteSteps = count >= 10000 ? 1 : 10;
+        double bruteTime = 0.0;
+        size_t contacts = 0;
+        for (int step = 0; step < bruteSteps; ++step)
+            bruteTime += bruteForceStep(hitboxes, contacts);
+
+        size_t brutePairTests = static_cast<size_t>(count) * (count - 1) / 2;
+
+        std::cout << std::setw(8) << count
+            << std::setw(16) << brutePairTests
+            << std::setw(14) << std::fixed << std::setprecision(3) << bruteTime / bruteSteps
+            << std::setw(16) << gridPairTests / steps
+            << std::setw(14) << gridTime / steps
+            << std::setw(10) << contacts
+            << std::endl;
+    }
+
+    void runIdlePopulation(int count)
+    {
+        std::mt19937 gen(5678);
+        auto gameObjects = createPopulation(count, gen);
+
+        // Only a tenth of the population keeps moving; the rest falls asleep after a while.
+        const size_t movingCount = gameObjects.size() / 10;
+        const int settleSteps = 60;
+        const int steps = 100;
+
+        for (int step = 0; step < settleSteps; ++step)
+        {
+            jitter(gameObjects, gen, movingCount);
+            Hitbox::resolveCollisions(gameObjects);
+        }
+
+        double gridTime = 0.0;
+        size_t gridPairTests = 0;
+        for (int step = 0; step < steps; ++step)
+        {
+            jitter(gameObjects, gen, movingCount);
+
+            auto start = Clock::now();
+            Hitbox::resolveCollisions(gameObjects);
+            gridTime += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            gridPairTests += Hitbox::getPairTestCount();
+        }
+
+        std::cout << std::setw(8) << count
+            << std::setw(10) << movingCount
+            << std::setw(10) << CollisionWorld::getInstance().getRestingCount()
+            << std::setw(16) << gridPairTests / steps
+            << std::setw(14) << std::fixed << std::setprecision(3) << gridTime / steps
+            << std::setw(10) << CollisionWorld::getInstance().getContactCount()
+            << std::endl;
+    }
+
+    struct BenchPosition
+    {
+        float x;
+        float y;
+    };
+
+    struct BenchVelocity
+    {
+        float x;
+        float y;
+    };
+
+    void runEntityPopulation(int count)
+    {
+        std::mt19937 gen(2468);
+        auto gameObjects = createPopulation(count, gen);
+
+        EntityRegistry registry;
+        for (auto& gameObject : gameObjects)
+        {
+            Entity entity = registry.create();
+            sf::Vector2f position = gameObject->getComponent<Transform>()->getPosition();
+            registry.add<BenchPosition>(entity, position.x, position.y);
+            registry.add<BenchVelocity>(entity, 1.0f, -1.0f);
+        }
+
+        const int steps = 100;
+        const float deltaTime = 1.0f / 60.0f;
+        const sf::Vector2f velocity(1.0f, -1.0f);
+
+        auto start = Clock::now();
+        for (int step = 0; step < steps; ++step)
+        {
+            for (auto& gameObject : gameObjects)
+            {
+                auto transform = gameObject->getComponent<Transform>();
+                transform->setPosition(transform->getPosition() + velocity * deltaTime);
+            }
+        }
+        double compositeTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (int step = 0; step < steps; ++step)
+        {
+            registry.each<BenchVelocity, BenchPosition>([deltaTime](Entity, BenchVelocity& velocity, BenchPosition& position)
+                {
+                    position.x += velocity.x * deltaTime;
+                    position.y += velocity.y * deltaTime;
+                });
+        }
+        double registryTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        // What the game runs for arrows: velocity in the registry, position still in the Transform.
+        EntityRegistry& gameRegistry = EntityRegistry::getInstance();
+        for (auto& gameObject : gameObjects)
+        {
+            auto link = std::make_shared<EntityLink>(gameRegistry);
+            gameObject->addComponent(link);
+            link->add<Motion>(gameObject->getComponent<Transform>(), velocity);
+        }
+
+        start = Clock::now();
+        for (int step = 0; step < steps; ++step)
+            MotionSystem::update(gameRegistry, deltaTime);
+        double motionTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        std::cout << std::setw(8) << count
+            << std::setw(16) << std::fixed << std::setprecision(4) << compositeTime / steps
+            << std::setw(16) << registryTime / steps
+            << std::setw(16) << motionTime / steps
+            << std::endl;
+    }
+
+    void runKernelPopulation(int count)
+    {
+        std::mt19937 gen(4321);
+        auto gameObjects = createPopulation(count, gen);
+
+        std::vector<Hitbox*> hitboxes;
+        AabbArray bounds;
+        for (auto& gameObject : gameObjects)
+        {
+            auto hitbox = gameObject->getComponent<Hitbox>();
+            auto transform = gameObject->getComponent<Transform>();
+
+            sf::Vector2f center = transform->getPosition() + hitbox->getOffset();
+            sf::Vector2f halfSize = hitbox->getSize() / 2.0f;
+
+            hitboxes.push_back(hitbox);
+            bounds.push_back(center.x - halfSize.x, center.y - halfSize.y, center.x + halfSize.x, center.y + halfSize.y);
+        }
+
+        size_t pairTests = static_cast<size_t>(count) * (count - 1) / 2;
+
+        auto start = Clock::now();
+        size_t checkHits = 0;
+        for (int idx = 0; idx < count; ++idx)
+        {
+            for (int jdx = idx + 1; jdx < count; ++jdx)
+            {
+                if (hitboxes[idx]->checkCollision(hitboxes[jdx]))
+                    ++checkHits;
+            }
+        }
+        double checkTime = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        start = Clock::now();
+        size_t soaHits = 0;
+        for (int idx = 0; idx < count; ++idx)
+        {
+            for (int jdx = idx + 1; jdx < count; ++jdx)
+            {
+                if (bounds.overlaps(idx, jdx))
+                    ++soaHits;
+            }
+        }
+        double soaTime = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        std::vector<int> hits(count);
+        start = Clock::now();
+        size_t kernelHits = 0;
+        for (int idx = 0; idx < count; ++idx)
+            kernelHits += AabbKernel::overlapRange(bounds, idx, idx + 1, count, hits.data());
+        double kernelTime = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        std::cout << std::setw(8) << count
+            << std::setw(16) << std::fixed << std::setprecision(2) << checkTime / pairTests
+            << std::setw(16) << soaTime / pairTests
+            << std::setw(16) << kernelTime / pairTests
+            << std::setw(10) << ((checkHits == soaHits && soaHits == kernelHits) ? "yes" : "NO")
+            << std::endl;
+    }
+}
+
+int main()
+{
+    WorldLimits::initialize(sf::FloatRect(0, 0, 3000, 2500));
+
+    std::cout << std::setw(8) << "boxes"
+        << std::setw(16) << "brute pairs"
+        << std::setw(14) << "brute ms"
+        << std::setw(16) << "grid pairs"
+        << std::setw(14) << "grid ms"
+        << std::setw(10) << "contacts"
+        << std::endl;
+
+    for (int count : { 100, 1000, 10000 })
+        runPopulation(count);
+
+    std::cout << std::endl << "Mostly idle population" << std::endl;
+    std::cout << std::setw(8) << "boxes"
+        << std::setw(10) << "moving"
+        << std::setw(10) << "resting"
+        << std::setw(16) << "grid pairs"
+        << std::setw(14) << "grid ms"
+        << std::setw(10) << "contacts"
+        << std::endl;
+
+    for (int count : { 1000, 10000 })
+        runIdlePopulation(count);
+
+    std::cout << std::endl << "Narrow phase kernel (" << AabbKernel::getInstructionSet() << "), ns per pair test" << std::endl;
+    std::cout << std::setw(8) << "boxes"
+        << std::setw(16) << "checkCollision"
+        << std::setw(16) << "scalar SoA"
+        << std::setw(16) << "batch kernel"
+        << std::setw(10) << "agree"
+        << std::endl;
+
+    for (int count : { 256, 1024, 4096 })
+        runKernelPopulation(count);
+
+    std::cout << std::endl << "Position integration, ms per step" << std::endl;
+    std::cout << std::setw(8) << "entities"
+        << std::setw(16) << "composite"
+        << std::setw(16) << "registry"
+        << std::setw(16) << "motion system"
+        << std::endl;
+
+    for (int count : { 1000, 10000, 100000 })
+        runEntityPopulation(count);
+
+    return 0;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+struct AabbArray
+{
+    std::vector<float> minX;
+    std::vector<float> minY;
+    std::vector<float> maxX;
+    std::vector<float> maxY;
+
+    void clear()
+    {
+        minX.clear();
+        minY.clear();
+        maxX.clear();
+        maxY.clear();
+    }
+
+    void push_back(float left, float top, float right, float bottom)
+    {
+        minX.push_back(left);
+        minY.push_back(top);
+        maxX.push_back(right);
+        maxY.push_back(bottom);
+    }
+
+    size_t size() const { return minX.size(); }
+
+    bool overlaps(size_t first, size_t second) const
+    {
+        return minX[first] <= maxX[second] && maxX[first] >= minX[second] &&
+            minY[first] <= maxY[second] && maxY[first] >= minY[second];
+    }
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+
+#include "AabbArray.h"
+
+class AabbKernel
+{
+public:
+    // Tests box `index` against bounds[candidates[0..count)] and writes the overlapping candidate
+    // ids to hits (which must hold count entries). Returns the number of hits.
+    static size_t overlapGather(const AabbArray& bounds, int index, const int* candidates, size_t count, int* hits);
+
+    // Same as overlapGather for the contiguous candidate range [begin, end).
+    static size_t overlapRange(const AabbArray& bounds, int index, int begin, int end, int* hits);
+
+    static const char* getInstructionSet();
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+// Counts calls to the global operator new / delete. The counting operators are only compiled in
+// when MINISTUDIO_COUNT_ALLOCATIONS is defined; otherwise every count stays at zero.
+class AllocationCounter
+{
+public:
+    static bool isEnabled();
+
+    static unsigned long long getAllocationCount();
+    static unsigned long long getDeallocationCount();
+};
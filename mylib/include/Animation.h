@@ -26,6 +26,9 @@ public:
     int getCurrentFrame() const;
     sf::IntRect getCurrentFrameRect() const;
 
+    // Frame rect relative to the image's region: an atlas page holds other images around it.
+    sf::IntRect getCurrentFrameRect(const sf::IntRect& region) const;
+
     std::string m_textureName;
 
 private:
@@ -45,6 +48,10 @@ public:
     AnimationComponent();
     ~AnimationComponent() override = default;
 
+    static constexpr ComponentType Type = ComponentType::AnimationComponent;
+    ComponentType getType() const override { return Type; }
+    unsigned getPhases() const override { return ComponentPhase::Update | ComponentPhase::Render; }
+
     void initialize() override;
     void update(const float& deltaTime) override;
     void render(sf::RenderWindow& window) override;
@@ -66,6 +73,7 @@ public:
 private:
     std::unordered_map<std::string, Animation> m_animations;
     std::string m_currentAnimation;
+    sf::IntRect m_textureRegion;
     sf::Sprite m_sprite;
     sf::Vector2f m_scale;
     bool m_playing;
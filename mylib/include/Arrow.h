@@ -7,9 +7,17 @@ public:
 	Arrow(const std::string& name = "Arrow", int damage = 10);
 	~Arrow() override;
 
+	static constexpr std::uint32_t Kind = EntityKind::Arrow;
+
 	void initialize(const sf::Vector2f& pos, const sf::Vector2f& direction, float speed) override;
 	void update(const float& deltaTime) override;
 
+	// Stops the registry from moving the arrow while it waits in a pool.
+	void deactivate();
+
 	int getDamage() const override;
 	bool isLifeTimePassed() const override;
+
+private:
+	void createComponents();
 };
\ No newline at end of file
@@ -94,6 +94,10 @@ public:
     CameraTarget(float weight = 1.0f, bool autoFollow = true);
     ~CameraTarget() override;
 
+    static constexpr ComponentType Type = ComponentType::CameraTarget;
+    ComponentType getType() const override { return Type; }
+    unsigned getPhases() const override { return ComponentPhase::None; }
+
     void initialize() override;
     void update(const float& deltaTime) override;
 
@@ -1,9 +1,27 @@
 #pragma once
 #include "Component.h"
+#include "ContactTable.h"
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <vector>
 
+namespace CollisionLayer
+{
+    enum : std::uint32_t
+    {
+        None = 0,
+        Default = 1u << 0,
+        Hero = 1u << 1,
+        Enemy = 1u << 2,
+        Projectile = 1u << 3,
+        Effect = 1u << 4,
+        World = 1u << 5,
+        All = ~0u
+    };
+}
+
 class Hitbox : public Component
 {
 public:
@@ -12,8 +30,11 @@ public:
     Hitbox(const sf::Vector2f& size = sf::Vector2f(50.0f, 50.0f));
     ~Hitbox() override;
 
+    static constexpr ComponentType Type = ComponentType::Hitbox;
+    ComponentType getType() const override { return Type; }
+    unsigned getPhases() const override { return ComponentPhase::Render; }
+
     void initialize() override;
-    void update(const float& deltaTime) override;
     void render(sf::RenderWindow& window) override;
 
     bool checkCollision(const Hitbox* other) const;
@@ -24,6 +45,33 @@ public:
     void setOffset(const sf::Vector2f& offset);
     sf::Vector2f getOffset() const;
 
+    void setCollisionLayer(std::uint32_t layer);
+    std::uint32_t getCollisionLayer() const;
+
+    void setCollisionMask(std::uint32_t mask);
+    std::uint32_t getCollisionMask() const;
+
+    bool canCollideWith(const Hitbox* other) const;
+
+    void setFastMoving(bool fastMoving);
+    bool isFastMoving() const;
+    void resetSweep();
+
+    // Static hitboxes never move on their own; sleeping ones fell asleep after staying still. While
+    // unchanged, both are kept out of the per-step broadphase and only tested against moving
+    // hitboxes. Moving a hitbox wakes it.
+    void setStatic(bool isStatic);
+    bool isStatic() const;
+
+    void setAutoSleep(bool autoSleep);
+    void sleep();
+    void wake();
+    bool isSleeping() const;
+
+    // Takes a new handle for a pooled hitbox coming back into play, so the contacts of its previous
+    // life end and new ones raise enter events again.
+    void recycle();
+
     void setEnterCollision(CollisionEvents events);
     void setExitCollision(CollisionEvents events);
 
@@ -32,19 +80,41 @@ public:
 
     void setDebugDraw(bool debugDraw);
 
+    HitboxHandle getHandle() const;
+
     static void resolveCollisions(const std::vector<std::shared_ptr<CompositeGameObject>>& gameObjects);
+    static size_t getPairTestCount();
 
 private:
     sf::Vector2f m_size;
     sf::Vector2f m_offset;
 
+    std::uint32_t m_layer;
+    std::uint32_t m_mask;
+
+    bool m_fastMoving;
+    bool m_hasPreviousCenter;
+    sf::Vector2f m_previousCenter;
+
+    bool m_static;
+    bool m_sleeping;
+    bool m_autoSleep;
+    int m_idleSteps;
+    bool m_hasLastBounds;
+    float m_lastBounds[4];
+    std::uint32_t m_restEligibleStep;
+    std::uint32_t m_restingStep;
+    int m_restingSlot;
+
     bool m_debugDraw;
     sf::RectangleShape m_debugShape;
 
-    std::vector<Hitbox*> m_currentCollisions;
+    HitboxHandle m_handle;
 
     CollisionEvents m_enterCollision;
     CollisionEvents m_exitCollision;
 
     void getBounds(float& minX, float& minY, float& maxX, float& maxY) const;
+
+    friend class CollisionWorld;
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+struct CollisionStepStats
+{
+    unsigned long long step = 0;
+
+    size_t hitboxes = 0;
+    size_t resting = 0;
+    size_t candidates = 0;
+    size_t narrowTests = 0;
+    size_t contacts = 0;
+    size_t enters = 0;
+    size_t exits = 0;
+
+    double gatherMs = 0.0;
+    double broadphaseMs = 0.0;
+    double narrowMs = 0.0;
+    double dispatchMs = 0.0;
+
+    // Longest single step, only filled in by getPeak: the per-phase peaks usually come from
+    // different steps, so their sum overstates it.
+    double peakTotalMs = 0.0;
+
+    double totalMs() const { return gatherMs + broadphaseMs + narrowMs + dispatchMs; }
+};
+
+class CollisionProfiler
+{
+public:
+    static CollisionProfiler& getInstance()
+    {
+        static CollisionProfiler instance;
+        return instance;
+    }
+
+    CollisionProfiler(const CollisionProfiler&) = delete;
+    CollisionProfiler& operator=(const CollisionProfiler&) = delete;
+
+    // Keeps the last historySize steps; older ones are overwritten.
+    void setHistorySize(size_t historySize);
+    size_t getHistorySize() const { return m_history.size(); }
+
+    void record(CollisionStepStats stats);
+    void clear();
+
+    size_t getRecordedCount() const { return m_count; }
+    const CollisionStepStats& getLast() const;
+
+    // Mean of every recorded step, with the counts rounded down.
+    CollisionStepStats getAverage() const;
+    CollisionStepStats getPeak() const;
+
+    // Writes the recorded steps, oldest first, with one header line. Returns false if the file
+    // could not be opened.
+    bool dumpCsv(const std::string& path) const;
+
+private:
+    CollisionProfiler();
+    ~CollisionProfiler() = default;
+
+    const CollisionStepStats& getRecorded(size_t age) const;
+
+    std::vector<CollisionStepStats> m_history;
+    size_t m_next;
+    size_t m_count;
+    unsigned long long m_step;
+};
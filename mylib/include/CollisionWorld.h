@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <SFML/System/Vector2.hpp>
+
+#include "AabbArray.h"
+#include "ContactTable.h"
+#include "SpatialGrid.h"
+
+class CompositeGameObject;
+class Hitbox;
+
+class CollisionWorld
+{
+public:
+    static CollisionWorld& getInstance()
+    {
+        static CollisionWorld instance;
+        return instance;
+    }
+
+    CollisionWorld(const CollisionWorld&) = delete;
+    CollisionWorld& operator=(const CollisionWorld&) = delete;
+
+    HitboxHandle registerHitbox(Hitbox* hitbox);
+    void unregisterHitbox(HitboxHandle handle);
+    Hitbox* resolve(HitboxHandle handle) const;
+
+    void resolveCollisions(const std::vector<std::shared_ptr<CompositeGameObject>>& gameObjects);
+
+    size_t getPairTestCount() const;
+    size_t getContactCount() const;
+    size_t getRestingCount() const;
+
+private:
+    CollisionWorld();
+    ~CollisionWorld() = default;
+
+    void gatherHitboxes(const std::vector<std::shared_ptr<CompositeGameObject>>& gameObjects);
+
+    // Static and sleeping hitboxes that did not move are kept in a persistent set with its own
+    // grid, rebuilt only when its membership changes. Moving hitboxes query that grid, while
+    // contacts between two resting hitboxes are carried over instead of being tested again.
+    struct RestingSet
+    {
+        std::vector<Hitbox*> hitboxes;
+        std::vector<HitboxHandle> handles;
+        std::vector<std::uint32_t> layers;
+        std::vector<std::uint32_t> masks;
+        std::vector<sf::Vector2f> centers;
+        std::vector<sf::Vector2f> halfSizes;
+        AabbArray bounds;
+        SpatialGrid grid;
+    };
+
+    void rebuildRestingSet();
+    void findRestingPairs(size_t activeCount);
+    void appendRestingSet();
+    void keepRestingContacts();
+
+    struct Batch
+    {
+        int index;
+        size_t begin;
+        size_t end;
+    };
+
+    struct alignas(64) WorkerBuffers
+    {
+        std::vector<int> hits;
+        std::vector<std::pair<HitboxHandle, HitboxHandle>> contacts;
+        size_t tests = 0;
+    };
+
+    void buildBatches();
+    void testBatches(size_t firstBatch, size_t lastBatch, WorkerBuffers& buffers) const;
+    bool sweptOverlap(int first, int second) const;
+
+    void dispatchEnter(HitboxHandle self, HitboxHandle other);
+    void dispatchExit(HitboxHandle self, HitboxHandle other);
+
+    SlotTable<Hitbox> m_hitboxSlots;
+
+    std::vector<Hitbox*> m_hitboxes;
+    std::vector<HitboxHandle> m_handles;
+    std::vector<std::uint32_t> m_layers;
+    std::vector<std::uint32_t> m_masks;
+    std::vector<std::uint8_t> m_fastFlags;
+    std::vector<sf::Vector2f> m_centers;
+    std::vector<sf::Vector2f> m_halfSizes;
+    std::vector<sf::Vector2f> m_displacements;
+    AabbArray m_bounds;
+
+    std::vector<std::pair<int, int>> m_candidatePairs;
+    std::vector<Batch> m_batches;
+    std::vector<int> m_batchCandidates;
+    std::vector<WorkerBuffers> m_workers;
+
+    RestingSet m_resting;
+    std::vector<Hitbox*> m_restingNow;
+    std::vector<int> m_restingQuery;
+    bool m_restingDirty;
+    std::uint32_t m_step;
+
+    SpatialGrid m_broadphase;
+    ContactTable m_contacts;
+    size_t m_pairTestCount;
+};
@@ -7,6 +7,35 @@
 class CompositeGameObject;
 class CameraTargetAdapter;
 
+// Built-in component types, each owning one slot in CompositeGameObject so getComponent<T>()
+// is an array index instead of a string lookup. Components outside this list use None and are
+// only reachable by name.
+enum class ComponentType
+{
+	None = -1,
+	Transform,
+	SquareRenderer,
+	PlayerController,
+	SoundComponent,
+	CameraTarget,
+	Hitbox,
+	AnimationComponent,
+	EntityLink,
+	Count
+};
+
+namespace ComponentPhase
+{
+	enum : unsigned
+	{
+		None = 0,
+		Input = 1u << 0,
+		Update = 1u << 1,
+		Render = 1u << 2,
+		All = Input | Update | Render
+	};
+}
+
 class Component
 {
 public:
@@ -21,20 +50,68 @@ public:
 	void setOwner(CompositeGameObject* owner);
 	CompositeGameObject* getOwner() const;
 
+	virtual ComponentType getType() const { return ComponentType::None; }
+
+	// Phases this component has work in; its owner only dispatches those. Components that do not
+	// say otherwise take part in every phase.
+	virtual unsigned getPhases() const { return ComponentPhase::All; }
+
+	// Lower priorities run first within a phase; equal priorities keep insertion order.
+	void setPriority(int priority);
+	int getPriority() const;
+
 	std::string getName() const;
 	void setName(const std::string& name);
 
 protected:
 	CompositeGameObject* m_owner;
 	std::string m_name;
+	int m_priority;
+};
+
+struct TransformData
+{
+	sf::Vector2f position;
+	sf::Vector2f velocity;
+};
+
+// Position and velocity of an object. Everything that moves or places the object goes through
+// this component; renderers and hitboxes only read it.
+class Transform : public Component
+{
+public:
+	Transform(const sf::Vector2f& position = sf::Vector2f(0.0f, 0.0f));
+	~Transform() = default;
+
+	static constexpr ComponentType Type = ComponentType::Transform;
+	ComponentType getType() const override { return Type; }
+	unsigned getPhases() const override { return ComponentPhase::None; }
+
+	const sf::Vector2f& getPosition() const { return m_data.position; }
+	void setPosition(const sf::Vector2f& position) { m_data.position = position; }
+	void move(const sf::Vector2f& offset) { m_data.position += offset; }
+
+	const sf::Vector2f& getVelocity() const { return m_data.velocity; }
+	void setVelocity(const sf::Vector2f& velocity) { m_data.velocity = velocity; }
+
+	const TransformData& getData() const { return m_data; }
+
+private:
+	TransformData m_data;
 };
 
+// Draws a square at its owner's Transform. Adds a Transform to the owner if it has none, and its
+// position accessors forward to it.
 class SquareRenderer : public Component
 {
 public:
 	SquareRenderer(float size, const sf::Color& color);
 	~SquareRenderer() = default;
 
+	static constexpr ComponentType Type = ComponentType::SquareRenderer;
+	ComponentType getType() const override { return Type; }
+	unsigned getPhases() const override { return ComponentPhase::Render; }
+
 	void initialize() override;
 	void render(sf::RenderWindow& window) override;
 
@@ -55,6 +132,10 @@ public:
 	PlayerController(float speed = 200.0f);
 	~PlayerController() = default;
 
+	static constexpr ComponentType Type = ComponentType::PlayerController;
+	ComponentType getType() const override { return Type; }
+	unsigned getPhases() const override { return ComponentPhase::Input | ComponentPhase::Update; }
+
 	void initialize() override;
 	void processInput(const sf::Event& event) override;
 	void update(const float& deltaTime) override;
@@ -88,6 +169,10 @@ public:
 	SoundComponent(const std::string& name = "SoundComponent");
 	~SoundComponent() override = default;
 
+	static constexpr ComponentType Type = ComponentType::SoundComponent;
+	ComponentType getType() const override { return Type; }
+	unsigned getPhases() const override { return ComponentPhase::None; }
+
 	void initialize() override;
 
 	void playSound(const std::string& soundName, float volume = 100.0f, float pitch = 1.0f);
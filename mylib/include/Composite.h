@@ -1,15 +1,46 @@
 #pragma once
+#include <array>
+#include <cstdint>
 #include <unordered_map>
+#include <vector>
 
 #include "Component.h"
 #include "GameObject.h"
+#include "Handle.h"
 #include "SceneBase.h"
 
+class CompositeGameObject;
+
+using GameObjectHandle = Handle<CompositeGameObject>;
+
+// What a scene object is, for checked downcasts without RTTI. Each class that can be cast to
+// declares `static constexpr std::uint32_t Kind` with every kind bit it covers, so a base such as
+// IEnemy matches all of its subclasses.
+namespace EntityKind
+{
+	enum : std::uint32_t
+	{
+		Generic = 0,
+		Hero = 1u << 0,
+		MeleeEnemy = 1u << 1,
+		RangedEnemy = 1u << 2,
+		Arrow = 1u << 3,
+		BloodEffect = 1u << 4,
+		TilesMap = 1u << 5,
+
+		Enemy = MeleeEnemy | RangedEnemy,
+		Projectile = Arrow
+	};
+}
+
 class CompositeGameObject : public GameObject
 {
 public:
 	CompositeGameObject(const std::string& name = "CompositeGameObject");
-	virtual ~CompositeGameObject() = default;
+	virtual ~CompositeGameObject();
+
+	CompositeGameObject(const CompositeGameObject&) = delete;
+	CompositeGameObject& operator=(const CompositeGameObject&) = delete;
 
 	void processInput(const sf::Event& event) override;
 	void update(const float& deltaTime) override;
@@ -20,8 +51,77 @@ public:
 	const Component* getComponent(const std::string& name) const;
 	void removeComponent(const std::string& name);
 
+	// Rebuilds the per-phase dispatch lists before the next dispatch.
+	void markDispatchDirty();
+
+	// Stable reference to this object for anything that does not own it. It resolves to nullptr
+	// once the object is destroyed, or once it is recycled after renewHandle.
+	GameObjectHandle getHandle() const { return m_handle; }
+	void renewHandle();
+
+	static CompositeGameObject* resolve(GameObjectHandle handle);
+
+	template <typename T>
+	static T* resolve(GameObjectHandle handle)
+	{
+		CompositeGameObject* object = resolve(handle);
+		return object ? object->template as<T>() : nullptr;
+	}
+
+	std::uint32_t getKind() const { return m_kind; }
+
+	// This object as a T, or nullptr when its kind is not one T covers.
+	template <typename T>
+	T* as()
+	{
+		return (m_kind & T::Kind) ? static_cast<T*>(this) : nullptr;
+	}
+
+	template <typename T>
+	const T* as() const
+	{
+		return (m_kind & T::Kind) ? static_cast<const T*>(this) : nullptr;
+	}
+
+	// Set while the object waits in its scene's destroy queue.
+	void setPendingDestroy(bool pendingDestroy) { m_pendingDestroy = pendingDestroy; }
+	bool isPendingDestroy() const { return m_pendingDestroy; }
+
+	// Fast path for the built-in component types: the last component of type T added to this
+	// object, or nullptr. The string overloads remain for named and custom components.
+	template <typename T>
+	T* getComponent()
+	{
+		return static_cast<T*>(m_slots[static_cast<size_t>(T::Type)]);
+	}
+
+	template <typename T>
+	const T* getComponent() const
+	{
+		return static_cast<const T*>(m_slots[static_cast<size_t>(T::Type)]);
+	}
+
+protected:
+	void setKind(std::uint32_t kind) { m_kind = kind; }
+
 private:
+	static SlotTable<CompositeGameObject>& getHandleTable();
+
+	void releaseSlot(const Component* component);
+	void forgetComponent(const Component* component);
+	void rebuildDispatchLists();
+
 	std::unordered_map<std::string, std::shared_ptr<Component>> m_components;
+	std::array<Component*, static_cast<size_t>(ComponentType::Count)> m_slots = {};
+
+	std::vector<Component*> m_insertionOrder;
+	std::vector<Component*> m_inputComponents;
+	std::vector<Component*> m_updateComponents;
+	std::vector<Component*> m_renderComponents;
+	bool m_dispatchDirty = false;
+	bool m_pendingDestroy = false;
+	std::uint32_t m_kind = EntityKind::Generic;
+	GameObjectHandle m_handle;
 };
 
 class CompositeScene : public SceneBase
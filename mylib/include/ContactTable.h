@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Handle.h"
+
+class Hitbox;
+
+using HitboxHandle = Handle<Hitbox>;
+
+class ContactTable
+{
+public:
+    struct Contact
+    {
+        HitboxHandle first;
+        HitboxHandle second;
+
+        bool operator==(const Contact& other) const
+        {
+            return first == other.first && second == other.second;
+        }
+
+        bool operator<(const Contact& other) const
+        {
+            return first != other.first ? first < other.first : second < other.second;
+        }
+    };
+
+    void beginStep();
+    void add(HitboxHandle first, HitboxHandle second);
+
+    // Diffs this step's contacts against the persistent set: onEnter(first, second) for new pairs,
+    // onExit(first, second) for pairs that ended. The current set then becomes the persistent one.
+    template <typename EnterFunction, typename ExitFunction>
+    void commit(EnterFunction&& onEnter, ExitFunction&& onExit);
+
+    const std::vector<Contact>& getContacts() const { return m_previous; }
+    size_t getContactCount() const { return m_previous.size(); }
+
+private:
+    void sortCurrent();
+
+    std::vector<Contact> m_previous;
+    std::vector<Contact> m_current;
+};
+
+template <typename EnterFunction, typename ExitFunction>
+void ContactTable::commit(EnterFunction&& onEnter, ExitFunction&& onExit)
+{
+    sortCurrent();
+
+    auto previous = m_previous.begin();
+    auto current = m_current.begin();
+
+    while (previous != m_previous.end() || current != m_current.end())
+    {
+        if (current == m_current.end() || (previous != m_previous.end() && *previous < *current))
+        {
+            onExit(previous->first, previous->second);
+            ++previous;
+        }
+        else if (previous == m_previous.end() || *current < *previous)
+        {
+            onEnter(current->first, current->second);
+            ++current;
+        }
+        else
+        {
+            ++previous;
+            ++current;
+        }
+    }
+
+    m_previous.swap(m_current);
+}
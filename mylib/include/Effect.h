@@ -9,6 +9,8 @@ public:
     BloodEffect(const std::string& name = "BloodEffect");
     ~BloodEffect() = default;
 
+    static constexpr std::uint32_t Kind = EntityKind::BloodEffect;
+
     void initialize(const sf::Vector2f& position, const sf::Vector2f& direction = sf::Vector2f(0, 1));
 	void update(const float& deltaTime) override;
 
@@ -19,5 +21,7 @@ public:
     void updateAnimation();
 
 private:
+    void createComponents();
+
     sf::Vector2f m_direction;
 };
\ No newline at end of file
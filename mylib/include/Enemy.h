@@ -7,6 +7,8 @@ public:
     MeleeEnemy(const std::string& name = "MeleeEnemy");
     ~MeleeEnemy();
 
+    static constexpr std::uint32_t Kind = EntityKind::MeleeEnemy;
+
     void init(const sf::Vector2f& pos);
 
     void Attack(float deltaTime) override;
@@ -33,6 +35,8 @@ public:
     RangedEnemy(const std::string& name = "RangedEnemy");
     ~RangedEnemy();
 
+    static constexpr std::uint32_t Kind = EntityKind::RangedEnemy;
+
     void init(const sf::Vector2f& pos);
 
     void Attack(float deltaTime) override;
@@ -2,11 +2,23 @@
 
 class IEnemy;
 
+enum class EnemyStateKind
+{
+    Patrol,
+    Chase,
+    Attack,
+    Retreat,
+    Positioning,
+    Count
+};
+
 class IEnemyState
 {
 public:
     virtual ~IEnemyState() = default;
 
+    virtual EnemyStateKind getKind() const = 0;
+
     virtual void enterState(IEnemy* enemy) = 0;
     virtual void update(IEnemy* enemy, float deltaTime) = 0;
     virtual void exitState(IEnemy* enemy) = 0;
@@ -17,6 +29,9 @@ namespace MeleeEnemyStates
     class PatrolState : public IEnemyState
     {
     public:
+        static constexpr EnemyStateKind Kind = EnemyStateKind::Patrol;
+        EnemyStateKind getKind() const override { return Kind; }
+
         void enterState(IEnemy* enemy) override;
         void update(IEnemy* enemy, float deltaTime) override;
         void exitState(IEnemy* enemy) override;
@@ -25,6 +40,9 @@ namespace MeleeEnemyStates
     class ChaseState : public IEnemyState
     {
     public:
+        static constexpr EnemyStateKind Kind = EnemyStateKind::Chase;
+        EnemyStateKind getKind() const override { return Kind; }
+
         void enterState(IEnemy* enemy) override;
         void update(IEnemy* enemy, float deltaTime) override;
         void exitState(IEnemy* enemy) override;
@@ -33,6 +51,9 @@ namespace MeleeEnemyStates
     class AttackState : public IEnemyState
     {
     public:
+        static constexpr EnemyStateKind Kind = EnemyStateKind::Attack;
+        EnemyStateKind getKind() const override { return Kind; }
+
         void enterState(IEnemy* enemy) override;
         void update(IEnemy* enemy, float deltaTime) override;
         void exitState(IEnemy* enemy) override;
@@ -45,6 +66,9 @@ namespace MeleeEnemyStates
     class RetreatState : public IEnemyState
     {
     public:
+        static constexpr EnemyStateKind Kind = EnemyStateKind::Retreat;
+        EnemyStateKind getKind() const override { return Kind; }
+
         void enterState(IEnemy* enemy) override;
         void update(IEnemy* enemy, float deltaTime) override;
         void exitState(IEnemy* enemy) override;
@@ -56,6 +80,9 @@ namespace RangedEnemyStates
     class PatrolState : public IEnemyState
     {
     public:
+        static constexpr EnemyStateKind Kind = EnemyStateKind::Patrol;
+        EnemyStateKind getKind() const override { return Kind; }
+
         void enterState(IEnemy* enemy) override;
         void update(IEnemy* enemy, float deltaTime) override;
         void exitState(IEnemy* enemy) override;
@@ -64,6 +91,9 @@ namespace RangedEnemyStates
     class PositioningState : public IEnemyState
     {
     public:
+        static constexpr EnemyStateKind Kind = EnemyStateKind::Positioning;
+        EnemyStateKind getKind() const override { return Kind; }
+
         void enterState(IEnemy* enemy) override;
         void update(IEnemy* enemy, float deltaTime) override;
         void exitState(IEnemy* enemy) override;
@@ -72,6 +102,9 @@ namespace RangedEnemyStates
     class AttackState : public IEnemyState
     {
     public:
+        static constexpr EnemyStateKind Kind = EnemyStateKind::Attack;
+        EnemyStateKind getKind() const override { return Kind; }
+
         void enterState(IEnemy* enemy) override;
         void update(IEnemy* enemy, float deltaTime) override;
         void exitState(IEnemy* enemy) override;
@@ -84,6 +117,9 @@ namespace RangedEnemyStates
     class RetreatState : public IEnemyState
     {
     public:
+        static constexpr EnemyStateKind Kind = EnemyStateKind::Retreat;
+        EnemyStateKind getKind() const override { return Kind; }
+
         void enterState(IEnemy* enemy) override;
         void update(IEnemy* enemy, float deltaTime) override;
         void exitState(IEnemy* enemy) override;
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Component.h"
+#include "EntityRegistry.h"
+
+// Adapter that gives a CompositeGameObject an entity in the data-oriented registry, so its
+// data can move into packed component arrays one piece at a time while the object keeps its
+// current interface. The entity is destroyed together with the component.
+class EntityLink : public Component
+{
+public:
+    EntityLink(EntityRegistry& registry = EntityRegistry::getInstance());
+    ~EntityLink() override;
+
+    static constexpr ComponentType Type = ComponentType::EntityLink;
+    ComponentType getType() const override { return Type; }
+    unsigned getPhases() const override { return ComponentPhase::None; }
+
+    void initialize() override;
+
+    // Points the entity's GameObjectRef at the owner's current handle. Called when the owner
+    // renews its handle, so the registry keeps resolving to it across pooled lives.
+    void refreshOwnerRef();
+
+    Entity getEntity() const;
+    EntityRegistry& getRegistry() const;
+
+    template <typename T, typename... Args>
+    T& add(Args&&... args)
+    {
+        return m_registry->add<T>(m_entity, std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    T* get()
+    {
+        return m_registry->tryGet<T>(m_entity);
+    }
+
+    template <typename T>
+    bool has() const
+    {
+        return m_registry->has<T>(m_entity);
+    }
+
+    template <typename T>
+    void remove()
+    {
+        m_registry->remove<T>(m_entity);
+    }
+
+private:
+    EntityRegistry* m_registry;
+    Entity m_entity;
+};
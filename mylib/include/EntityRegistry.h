@@ -0,0 +1,216 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "Handle.h"
+
+class CompositeGameObject;
+
+struct EntityTag;
+using Entity = Handle<EntityTag>;
+
+// Back reference from an entity to the CompositeGameObject it was created for, set by EntityLink.
+// Resolve it with CompositeGameObject::resolve; it goes stale when the object is destroyed, and
+// EntityLink refreshes it when the object is recycled.
+struct GameObjectRef
+{
+    Handle<CompositeGameObject> object;
+};
+
+class IComponentPool
+{
+public:
+    virtual ~IComponentPool() = default;
+
+    virtual bool contains(std::uint32_t index) const = 0;
+    virtual void remove(std::uint32_t index) = 0;
+};
+
+// Sparse set: components of one type packed in a dense array, with a sparse table from entity
+// index to dense slot. Removal swaps the last component into the hole, so the array stays
+// contiguous but its order is not stable.
+template <typename T>
+class ComponentPool : public IComponentPool
+{
+public:
+    template <typename... Args>
+    T& emplace(std::uint32_t index, Args&&... args)
+    {
+        if (contains(index))
+        {
+            m_components[m_sparse[index]] = T{ std::forward<Args>(args)... };
+            return m_components[m_sparse[index]];
+        }
+
+        if (index >= m_sparse.size())
+            m_sparse.resize(index + 1, npos);
+
+        m_sparse[index] = static_cast<std::uint32_t>(m_dense.size());
+        m_dense.push_back(index);
+        m_components.push_back(T{ std::forward<Args>(args)... });
+        return m_components.back();
+    }
+
+    bool contains(std::uint32_t index) const override
+    {
+        return index < m_sparse.size() && m_sparse[index] != npos;
+    }
+
+    void remove(std::uint32_t index) override
+    {
+        if (!contains(index))
+            return;
+
+        std::uint32_t slot = m_sparse[index];
+        std::uint32_t last = static_cast<std::uint32_t>(m_dense.size() - 1);
+
+        if (slot != last)
+        {
+            m_components[slot] = std::move(m_components[last]);
+            m_dense[slot] = m_dense[last];
+            m_sparse[m_dense[slot]] = slot;
+        }
+
+        m_components.pop_back();
+        m_dense.pop_back();
+        m_sparse[index] = npos;
+    }
+
+    T& get(std::uint32_t index) { return m_components[m_sparse[index]]; }
+    const T& get(std::uint32_t index) const { return m_components[m_sparse[index]]; }
+
+    size_t size() const { return m_components.size(); }
+
+    // Entity index owning each packed component, in the same order as getComponents().
+    const std::vector<std::uint32_t>& getEntityIndices() const { return m_dense; }
+    std::vector<T>& getComponents() { return m_components; }
+    const std::vector<T>& getComponents() const { return m_components; }
+
+private:
+    static constexpr std::uint32_t npos = ~0u;
+
+    std::vector<std::uint32_t> m_sparse;
+    std::vector<std::uint32_t> m_dense;
+    std::vector<T> m_components;
+};
+
+class EntityRegistry
+{
+public:
+    static EntityRegistry& getInstance()
+    {
+        static EntityRegistry instance;
+        return instance;
+    }
+
+    EntityRegistry();
+
+    EntityRegistry(const EntityRegistry&) = delete;
+    EntityRegistry& operator=(const EntityRegistry&) = delete;
+
+    Entity create();
+    void destroy(Entity entity);
+    bool isAlive(Entity entity) const;
+    size_t getAliveCount() const { return m_aliveCount; }
+
+    template <typename T, typename... Args>
+    T& add(Entity entity, Args&&... args)
+    {
+        return getPool<T>().emplace(entity.index, std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    void remove(Entity entity)
+    {
+        if (isAlive(entity))
+            getPool<T>().remove(entity.index);
+    }
+
+    template <typename T>
+    bool has(Entity entity) const
+    {
+        const ComponentPool<T>* pool = findPool<T>();
+        return pool && isAlive(entity) && pool->contains(entity.index);
+    }
+
+    template <typename T>
+    T* tryGet(Entity entity)
+    {
+        ComponentPool<T>* pool = findPool<T>();
+        if (!pool || !isAlive(entity) || !pool->contains(entity.index))
+            return nullptr;
+
+        return &pool->get(entity.index);
+    }
+
+    template <typename T>
+    ComponentPool<T>& getPool()
+    {
+        size_t id = poolId<T>();
+        if (id >= m_pools.size())
+            m_pools.resize(id + 1);
+
+        if (!m_pools[id])
+            m_pools[id] = std::make_unique<ComponentPool<T>>();
+
+        return static_cast<ComponentPool<T>&>(*m_pools[id]);
+    }
+
+    // Calls function(entity, first, rest...) for every entity holding all the listed components.
+    // Iteration walks the packed array of First, so list the rarest component first. Components
+    // must not be added or removed from inside the loop.
+    template <typename First, typename... Rest, typename Function>
+    void each(Function&& function)
+    {
+        ComponentPool<First>& firstPool = getPool<First>();
+        auto pools = std::make_tuple(&getPool<Rest>()...);
+        (void)pools;
+
+        const std::vector<std::uint32_t>& indices = firstPool.getEntityIndices();
+        std::vector<First>& components = firstPool.getComponents();
+
+        for (size_t slot = 0; slot < indices.size(); ++slot)
+        {
+            std::uint32_t index = indices[slot];
+            if (!(std::get<ComponentPool<Rest>*>(pools)->contains(index) && ...))
+                continue;
+
+            function(Entity{ index, m_generations[index] }, components[slot], std::get<ComponentPool<Rest>*>(pools)->get(index)...);
+        }
+    }
+
+private:
+    static size_t nextPoolId()
+    {
+        static size_t nextId = 0;
+        return nextId++;
+    }
+
+    template <typename T>
+    static size_t poolId()
+    {
+        static const size_t id = nextPoolId();
+        return id;
+    }
+
+    template <typename T>
+    ComponentPool<T>* findPool() const
+    {
+        size_t id = poolId<T>();
+        if (id >= m_pools.size() || !m_pools[id])
+            return nullptr;
+
+        return static_cast<ComponentPool<T>*>(m_pools[id].get());
+    }
+
+    std::vector<std::uint32_t> m_generations;
+    std::vector<std::uint8_t> m_alive;
+    std::vector<std::uint32_t> m_freeIndices;
+    std::vector<std::unique_ptr<IComponentPool>> m_pools;
+    size_t m_aliveCount;
+};
@@ -2,11 +2,16 @@
 #include "Arrow.h"
 #include "SceneBase.h"
 #include "Hero.h"
+#include "ObjectPool.h"
 #include "Tiles.h"
 
+class BloodEffect;
 class IEnemy;
+class MeleeEnemy;
+class RangedEnemy;
 class Hitbox;
 class ScoreUI;
+class CollisionStatsUI;
 
 class Game : public SceneBase
 {
@@ -21,8 +26,17 @@ public:
     static Game* getInstance();
 
     std::shared_ptr<Arrow> createArrow(const sf::Vector2f& pos, const sf::Vector2f& direction, int damage);
+    std::shared_ptr<BloodEffect> createBloodEffect(const sf::Vector2f& position, const sf::Vector2f& direction);
     void addEffect(std::shared_ptr<CompositeGameObject> effect);
 
+    // Every object enters the scene through here, so the per-category lists below stay in step
+    // with m_gameObjects.
+    void addGameObject(const std::shared_ptr<CompositeGameObject>& object);
+
+    // Queues object for removal. It stays in the scene until the end of the current step, when all
+    // queued objects are taken out in one pass and handed back to their pools.
+    void destroy(CompositeGameObject* object);
+
     int getScore() const { return m_score; }
     void addScore(int points);
     void resetScore() { m_score = 0; }
@@ -53,14 +67,16 @@ private:
     sf::Vector2f getRandomSpawnPosition();
     std::shared_ptr<IEnemy> createRandomEnemy(const sf::Vector2f& position, int index);
     int getCurrentEnemyCount() const;
-    void cleanupDeadEnemies();
 
 private:
-    void cleanupProjectiles();
-    void cleanupEffects();
+    void queueFinishedObjects();
+    void flushDestroyQueue();
+    void sortRenderList();
+    void recycle(std::shared_ptr<CompositeGameObject> object);
 
     void setupHealthUI();
     void setupScoreUI();
+    void setupCollisionStatsUI();
 
     void setMap();
     void setLayer();
@@ -70,13 +86,41 @@ private:
     bool m_deadPlayer;
 
     std::vector<std::shared_ptr<CompositeGameObject>> m_gameObjects;
+    std::vector<std::shared_ptr<CompositeGameObject>> m_destroyed;
+    size_t m_pendingDestroyCount = 0;
     static Game* m_gameInstance;
 
+    // Per-category views of m_gameObjects, filled on spawn and pruned in flushDestroyQueue.
+    std::vector<IEnemy*> m_enemies;
+    std::vector<IProjectile*> m_projectiles;
+    std::vector<BloodEffect*> m_effects;
+    std::vector<CompositeGameObject*> m_uiObjects;
+    int m_aliveEnemyCount = 0;
+
+    // World objects in draw order: dead enemies first, then by Y. Entries live as long as their
+    // object; only the cached keys are refreshed each frame before an insertion sort, which is
+    // close to linear since few objects change places between two frames.
+    struct RenderEntry
+    {
+        CompositeGameObject* object;
+        IEnemy* enemy;
+        bool dead;
+        float y;
+    };
+    std::vector<RenderEntry> m_renderList;
+
+    // Arrows, effects and enemies that left the scene wait here to be reused by the next spawn.
+    ObjectPool<Arrow> m_arrowPool;
+    ObjectPool<BloodEffect> m_bloodEffectPool;
+    ObjectPool<MeleeEnemy> m_meleeEnemyPool;
+    ObjectPool<RangedEnemy> m_rangedEnemyPool;
+
     std::shared_ptr<TilesMap> m_map;
     std::shared_ptr<TilesMap> m_mapLayers;
 
     int m_score = 0;
     std::shared_ptr<ScoreUI> m_scoreUI;
+    std::shared_ptr<CollisionStatsUI> m_collisionStatsUI;
 
     void displayGameOver();
     sf::Text m_gameOverText;
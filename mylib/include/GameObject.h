@@ -1,7 +1,7 @@
 #pragma once
 #include "IGameObject.h"
+#include "TagRegistry.h"
 #include <algorithm>
-#include <unordered_set>
 
 class GameObject : public IGameObject
 {
@@ -20,17 +20,27 @@ public:
 	void setName(const std::string& name) override;
 	std::string getName() const override;
 
+	// Names are interned through TagRegistry; per-frame code should use the id overloads, which
+	// never touch a string.
 	void setCategory(const std::string& category);
-	std::string getCategory() const;
+	void setCategory(TagId category);
+	const std::string& getCategory() const;
+	TagId getCategoryId() const { return m_category; }
+	bool isCategory(TagId category) const { return m_category == category; }
 
 	void addTag(const std::string& tag);
+	void addTag(TagId tag);
 	void removeTag(const std::string& tag);
+	void removeTag(TagId tag);
 	bool hasTag(const std::string& tag) const;
-	const std::unordered_set<std::string>& getTags() const;
+	bool hasTag(TagId tag) const { return (m_tags & TagRegistry::bit(tag)) != 0; }
+	bool hasAnyTag(TagMask tags) const { return (m_tags & tags) != 0; }
+	bool hasAllTags(TagMask tags) const { return (m_tags & tags) == tags; }
+	TagMask getTags() const { return m_tags; }
 
 protected:
 	std::string m_name;
-	std::string m_category;
-	std::unordered_set<std::string> m_tags;
+	TagId m_category;
+	TagMask m_tags;
 	std::vector<std::shared_ptr<IGameObject>> m_children;
 };
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Index into a SlotTable plus the generation the slot had when the handle was issued. Freeing a
+// slot bumps its generation, so handles to whatever lived there before stop resolving. T only
+// tags the handle; a default constructed handle never resolves.
+template <typename T>
+struct Handle
+{
+    std::uint32_t index = 0;
+    std::uint32_t generation = 0;
+
+    bool operator==(const Handle& other) const
+    {
+        return index == other.index && generation == other.generation;
+    }
+
+    bool operator!=(const Handle& other) const
+    {
+        return !(*this == other);
+    }
+
+    bool operator<(const Handle& other) const
+    {
+        return index != other.index ? index < other.index : generation < other.generation;
+    }
+};
+
+// Issues handles to objects it does not own. Resolving is two array reads and gives nullptr once
+// the object was erased, even if its slot has been reused since.
+template <typename T>
+class SlotTable
+{
+public:
+    SlotTable()
+        : m_count(0)
+    {
+    }
+
+    Handle<T> insert(T* object)
+    {
+        std::uint32_t index;
+        if (!m_free.empty())
+        {
+            index = m_free.back();
+            m_free.pop_back();
+        }
+        else
+        {
+            index = static_cast<std::uint32_t>(m_slots.size());
+            m_slots.push_back({ nullptr, 1 });
+        }
+
+        m_slots[index].object = object;
+        ++m_count;
+        return { index, m_slots[index].generation };
+    }
+
+    void erase(Handle<T> handle)
+    {
+        if (!resolve(handle))
+            return;
+
+        Slot& slot = m_slots[handle.index];
+        slot.object = nullptr;
+        ++slot.generation;
+
+        m_free.push_back(handle.index);
+        --m_count;
+    }
+
+    T* resolve(Handle<T> handle) const
+    {
+        if (handle.index >= m_slots.size())
+            return nullptr;
+
+        const Slot& slot = m_slots[handle.index];
+        return slot.generation == handle.generation ? slot.object : nullptr;
+    }
+
+    size_t size() const { return m_count; }
+
+private:
+    struct Slot
+    {
+        T* object;
+        std::uint32_t generation;
+    };
+
+    std::vector<Slot> m_slots;
+    std::vector<std::uint32_t> m_free;
+    size_t m_count;
+};
@@ -26,6 +26,8 @@ public:
     Hero(const std::string& name = "Hero");
     ~Hero() = default;
 
+    static constexpr std::uint32_t Kind = EntityKind::Hero;
+
     void initialize(const sf::Vector2f& position, const float& size,
     const sf::Color& color, const float& speed);
 
@@ -1,4 +1,7 @@
 #pragma once
+#include <array>
+#include <memory>
+
 #include "Composite.h"
 #include "EnemyState.h"
 
@@ -16,9 +19,15 @@ public:
     IEnemy(const std::string& name = "Enemy");
     virtual ~IEnemy();
 
+    static constexpr std::uint32_t Kind = EntityKind::Enemy;
+
     void init(const sf::Vector2f& position, const float& size,
         const sf::Color& color, const float& speed);
 
+    // Brings a pooled enemy back to life at position. The components of its previous life are
+    // kept; only gameplay state, position and collision handle are reset.
+    void respawn(const sf::Vector2f& position);
+
     void update(const float& deltaTime) override;
 
     bool isHealthCritical() const;
@@ -37,10 +46,11 @@ public:
     void takeDamage(int amount, const sf::Vector2f& attackerPos);
     void forgetPlayer();
     void updateLOS(const sf::Vector2f& playerPos);
-    static void updateAllEnemyLOS(std::vector<std::shared_ptr<CompositeGameObject>>& gameObjects,
-        const sf::Vector2f& playerPos);
+    static void updateAllEnemyLOS(const std::vector<IEnemy*>& enemies, const sf::Vector2f& playerPos);
 
-    void changeState(IEnemyState* newState);
+    // Switches to the enemy's own instance of that state. The instances are created once with the
+    // enemy, so a transition never allocates.
+    void changeState(EnemyStateKind kind);
     void updateAnimation();
     void updateVisualDirection();
 
@@ -50,13 +60,14 @@ public:
 
     void setSpawnPosition(const sf::Vector2f& pos);
 
-    static void heroIsDead(std::vector<std::shared_ptr<CompositeGameObject>>& gameObjects);
+    static void heroIsDead(const std::vector<IEnemy*>& enemies);
 
 protected:
     int m_health;
     int m_maxHealth;
     int m_damage;
     float m_speed;
+    float m_bodyRadius = 0.0f;
     bool m_isDead = false;
 
     float m_detectionRadius;
@@ -75,6 +86,15 @@ protected:
     std::vector<sf::Vector2f> m_patrolPoints;
     int m_currentPatrolPoint;
 
+    template <typename... States>
+    void createStates()
+    {
+        (setState(std::make_unique<States>()), ...);
+    }
+
+    void setState(std::unique_ptr<IEnemyState> state);
+
+    std::array<std::unique_ptr<IEnemyState>, static_cast<size_t>(EnemyStateKind::Count)> m_states;
     IEnemyState* m_currentState;
 
     float m_timerForPatrol;
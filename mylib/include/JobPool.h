@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobPool
+{
+public:
+    using Job = std::function<void(size_t begin, size_t end, unsigned worker)>;
+
+    static JobPool& getInstance()
+    {
+        static JobPool instance;
+        return instance;
+    }
+
+    JobPool(const JobPool&) = delete;
+    JobPool& operator=(const JobPool&) = delete;
+
+    // Number of threads that can run a job at once, the calling thread included. Worker indices
+    // passed to jobs are always below this.
+    unsigned getWorkerCount() const;
+
+    // Splits [0, count) into chunks of at least minChunk items and runs job on them across the
+    // pool. The calling thread takes part and the call returns once every chunk is done.
+    void parallelFor(size_t count, size_t minChunk, const Job& job);
+
+private:
+    JobPool();
+    ~JobPool();
+
+    void workerLoop(unsigned worker);
+    void runChunks(unsigned worker);
+
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeWorkers;
+    std::condition_variable m_jobDone;
+
+    const Job* m_job;
+    size_t m_count;
+    size_t m_chunk;
+    std::atomic<size_t> m_next;
+    unsigned m_busyWorkers;
+    unsigned long long m_jobGeneration;
+    bool m_stopping;
+};
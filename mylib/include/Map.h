@@ -1,5 +1,8 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <vector>
+
+class TilesMap;
 
 class WorldLimits
 {
@@ -39,6 +42,17 @@ public:
         return result;
     }
 
+    static void addSolidMap(const TilesMap* tilesMap);
+    static void removeSolidMap(const TilesMap* tilesMap);
+
+    // Moves an entity from `from` toward `to` one axis at a time, stopping against the solid tiles
+    // of the registered maps, then clamps the result to the world bounds. An entity that already
+    // overlaps a solid tile moves freely so it can get out.
+    static sf::Vector2f move(const sf::Vector2f& from, const sf::Vector2f& to, float entityRadius = 0.0f);
+
 private:
+    static bool isBlocked(const sf::Vector2f& position, float entityRadius);
+
     static sf::FloatRect m_world_bounds;
+    static std::vector<const TilesMap*> m_solid_maps;
 };
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <SFML/System/Vector2.hpp>
+
+#include "EntityRegistry.h"
+
+class Transform;
+
+// Constant velocity of a linked object, kept in the registry. The position itself still lives in
+// the owner's Transform, which the system moves through the stored pointer.
+struct Motion
+{
+    Transform* transform;
+    sf::Vector2f velocity;
+};
+
+class MotionSystem
+{
+public:
+    // Moves every entity holding a Motion by velocity * deltaTime, walking the packed Motion array.
+    static void update(EntityRegistry& registry, float deltaTime);
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Keeps objects that left the scene so a later spawn can take them back instead of building new
+// ones. Objects keep their components between lives; whoever acquires one re-initializes it.
+template <typename T>
+class ObjectPool
+{
+public:
+    ObjectPool()
+        : m_created(0)
+        , m_reused(0)
+    {
+    }
+
+    // Returns a released object when there is one, otherwise a new one built from args.
+    template <typename... Args>
+    std::shared_ptr<T> acquire(Args&&... args)
+    {
+        if (m_free.empty())
+        {
+            ++m_created;
+            return std::make_shared<T>(std::forward<Args>(args)...);
+        }
+
+        std::shared_ptr<T> object = std::move(m_free.back());
+        m_free.pop_back();
+        ++m_reused;
+        return object;
+    }
+
+    // Takes the object back once nothing else holds it. Objects still shared elsewhere are left to
+    // be destroyed by their last owner.
+    void release(std::shared_ptr<T> object)
+    {
+        if (object && object.use_count() == 1)
+            m_free.push_back(std::move(object));
+    }
+
+    void reserve(size_t count) { m_free.reserve(count); }
+    void clear() { m_free.clear(); }
+
+    size_t getFreeCount() const { return m_free.size(); }
+    size_t getCreatedCount() const { return m_created; }
+    size_t getReusedCount() const { return m_reused; }
+
+private:
+    std::vector<std::shared_ptr<T>> m_free;
+    size_t m_created;
+    size_t m_reused;
+};
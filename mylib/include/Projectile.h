@@ -8,6 +8,8 @@ public:
 	IProjectile(const std::string& name = "Projectile");
 	virtual ~IProjectile();
 
+	static constexpr std::uint32_t Kind = EntityKind::Projectile;
+
 	virtual void initialize(const sf::Vector2f& pos, const sf::Vector2f& direction, float speed);
 	void update(const float& deltaTime) override;
 
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "AabbArray.h"
+
+class SpatialGrid
+{
+public:
+    SpatialGrid(const sf::FloatRect& worldBounds = sf::FloatRect(0, 0, 3000, 2500), float cellSize = 128.0f);
+
+    void setWorldBounds(const sf::FloatRect& worldBounds);
+    void setCellSize(float cellSize);
+
+    // Bins every box whose layer and mask are non-empty. The arrays are read again by findPairs
+    // and query, so they must stay untouched while the grid is in use.
+    void build(const AabbArray& bounds, const std::vector<std::uint32_t>& layers, const std::vector<std::uint32_t>& masks);
+
+    // Fills pairs with every (low id, high id) couple sharing a cell whose layers accept each
+    // other, each reported once and sorted.
+    void findPairs(std::vector<std::pair<int, int>>& pairs);
+
+    // Appends to ids every binned box sharing a cell with the given bounds whose layers accept
+    // (layer, mask), each reported once.
+    void query(float minX, float minY, float maxX, float maxY, std::uint32_t layer, std::uint32_t mask, std::vector<int>& ids);
+
+    const sf::FloatRect& getWorldBounds() const { return m_worldBounds; }
+
+    int getColumnCount() const { return m_columns; }
+    int getRowCount() const { return m_rows; }
+    float getCellSize() const { return m_cellSize; }
+
+private:
+    void rebuildLayout();
+
+    int cellColumn(float x) const;
+    int cellRow(float y) const;
+
+    struct Entry
+    {
+        int cell;
+        int id;
+    };
+
+    sf::FloatRect m_worldBounds;
+    float m_cellSize;
+    int m_columns;
+    int m_rows;
+
+    const AabbArray* m_bounds;
+    const std::vector<std::uint32_t>* m_layers;
+    const std::vector<std::uint32_t>* m_masks;
+
+    std::vector<Entry> m_entries;
+    std::vector<int> m_cellStart;
+    std::vector<int> m_cellIds;
+
+    std::vector<std::uint32_t> m_queryMarks;
+    std::uint32_t m_queryMark;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+class SpriteBatch
+{
+public:
+    static SpriteBatch& getInstance()
+    {
+        static SpriteBatch instance;
+        return instance;
+    }
+
+    SpriteBatch(const SpriteBatch&) = delete;
+    SpriteBatch& operator=(const SpriteBatch&) = delete;
+
+    // Depth given to the quads submitted from now on. Higher depths are drawn on top.
+    void setDepth(float depth) { m_depth = depth; }
+    float getDepth() const { return m_depth; }
+
+    void submit(const sf::Texture* texture, const sf::IntRect& rect, const sf::Transform& transform, const sf::Color& color);
+    void submit(const sf::Sprite& sprite);
+
+    // Sorts the queued quads by depth then texture and draws them in as few calls as possible. A
+    // quad joins an earlier batch of its texture when nothing drawn in between overlaps it, so
+    // the result looks the same as drawing the quads one by one in depth order.
+    void flush(sf::RenderTarget& target);
+
+    // Counts for the last flush: the draw calls issued and the quads they covered, which is also
+    // the number of draw calls an unbatched render would have needed.
+    size_t getDrawCallCount() const { return m_drawCallCount; }
+    size_t getQuadCount() const { return m_quadCount; }
+
+private:
+    SpriteBatch();
+    ~SpriteBatch() = default;
+
+    struct Quad
+    {
+        const sf::Texture* texture;
+        float depth;
+        size_t order;
+        sf::FloatRect bounds;
+        sf::Vertex vertices[4];
+    };
+
+    struct Batch
+    {
+        const sf::Texture* texture;
+        sf::FloatRect bounds;
+        sf::VertexArray vertices;
+    };
+
+    std::vector<Quad> m_quads;
+    std::vector<Batch> m_batches;
+    float m_depth;
+    size_t m_drawCallCount;
+    size_t m_quadCount;
+};
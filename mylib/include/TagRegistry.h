@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using TagId = std::uint8_t;
+using TagMask = std::uint64_t;
+
+// Built-in categories and tags. The registry interns their names first, in this order, so the
+// string and id forms of a built-in always agree.
+namespace Category
+{
+    enum : TagId
+    {
+        None = 0,
+        Player,
+        Enemy,
+        Projectile,
+        Effect,
+        UI,
+        BuiltinCount
+    };
+}
+
+namespace Tag
+{
+    enum : TagId
+    {
+        Hero = 0,
+        Arrow,
+        MeleeEnemy,
+        RangedEnemy,
+        BuiltinCount
+    };
+}
+
+// Maps category and tag names to small ids. Names are interned when an object registers them;
+// per-frame queries only compare ids and test masks.
+class TagRegistry
+{
+public:
+    static constexpr TagId invalid = 0xFF;
+    static constexpr TagId maxTags = 64;
+
+    static TagRegistry& getInstance()
+    {
+        static TagRegistry instance;
+        return instance;
+    }
+
+    static constexpr TagMask bit(TagId id) { return id < maxTags ? TagMask(1) << id : 0; }
+
+    // Returns the id of name, registering it first if needed. Tags are limited to maxTags;
+    // past that internTag returns invalid.
+    TagId internCategory(const std::string& name);
+    TagId internTag(const std::string& name);
+
+    // Looks name up without registering it. Returns invalid for unknown names.
+    TagId findCategory(const std::string& name) const;
+    TagId findTag(const std::string& name) const;
+
+    const std::string& getCategoryName(TagId category) const;
+    const std::string& getTagName(TagId tag) const;
+
+private:
+    TagRegistry();
+
+    struct NameTable
+    {
+        std::unordered_map<std::string, TagId> ids;
+        std::vector<std::string> names;
+
+        TagId intern(const std::string& name, size_t limit);
+        TagId find(const std::string& name) const;
+        const std::string& getName(TagId id) const;
+    };
+
+    NameTable m_categories;
+    NameTable m_tags;
+};
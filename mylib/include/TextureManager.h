@@ -4,6 +4,15 @@
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <vector>
+
+// Part of a texture holding one loaded image: the whole texture for images loaded on their own,
+// or the image's spot on an atlas page.
+struct TextureRegion
+{
+    sf::Texture* texture = nullptr;
+    sf::IntRect rect;
+};
 
 class TextureManager
 {
@@ -19,10 +28,19 @@ public:
 
     bool loadTexture(const std::string& name, const std::string& filename);
 
+    // For an atlas image this is the whole atlas page; use getRegion for the image's rect.
     sf::Texture* getTexture(const std::string& name);
 
+    TextureRegion getRegion(const std::string& name);
+
     bool hasTexture(const std::string& name) const;
 
+    // Packs the given images onto as few atlas pages as they fit, so sprites drawn from any of
+    // them share a texture. Images already loaded or too large for a page are loaded on their own.
+    bool loadAtlas(const std::vector<std::pair<std::string, std::string>>& images);
+
+    size_t getAtlasPageCount() const { return m_atlasPages.size(); }
+
     void loadAllGameTextures();
 
 private:
@@ -30,5 +48,7 @@ private:
     ~TextureManager();
 
     std::unordered_map<std::string, std::unique_ptr<sf::Texture>> m_textures;
+    std::unordered_map<std::string, TextureRegion> m_atlasRegions;
+    std::vector<std::unique_ptr<sf::Texture>> m_atlasPages;
     bool m_initialized;
 };
\ No newline at end of file
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <array>
+#include <memory>
 #include <string>
+#include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
 #include "Composite.h"
 #include "PathManager.h"
 #include "TextureManager.h"
@@ -16,14 +20,33 @@ class TilesMap : public CompositeGameObject
 {
 public:
     TilesMap(const std::string& name, const MapRepresentation& repr, int tileSize = 16);
+    ~TilesMap() override;
+
+    static constexpr std::uint32_t Kind = EntityKind::TilesMap;
 
     using TileType = char;
 
+    // Layers are drawn from square chunks of chunkTiles x chunkTiles tiles, each baked into one
+    // vertex array. A chunk is rebuilt only after setTile or setScale touched it.
+    static constexpr int chunkTiles = 16;
+
+    struct Chunk
+    {
+        sf::VertexArray vertices = sf::VertexArray(sf::Quads);
+        bool dirty = true;
+    };
+
     struct Layer
     {
         std::vector<TileType> tiles;
         bool visible = true;
         int tileSize = 16;
+        std::array<bool, 256> solid = {};
+        bool hasSolid = false;
+
+        std::vector<Chunk> chunks;
+        int chunkColumns = 0;
+        int chunkRows = 0;
     };
 
     void addLayer(const MapRepresentation& repr, int tileSize = 16);
@@ -32,8 +55,24 @@ public:
 
     void setTile(int layerIndex, int row, int col, TileType tileType);
 
+    void setTileSolid(int layerIndex, TileType tileType, bool solid);
+    bool isTileSolid(int layerIndex, int row, int col) const;
+
+    // True when the area touches a solid tile of any layer. Only the tiles under the area are
+    // looked up, so the cost does not depend on how many solid tiles the map holds.
+    bool isAreaSolid(const sf::FloatRect& area) const;
+
     void setScale(float scaleX, float scaleY);
 
+    // Pre-renders the map into pageSize x pageSize pixel render textures and draws those instead
+    // of the chunks. Pages are only rendered when the camera scrolls onto them or a tile under
+    // them changes; at most pageBudget pages stay resident, the least recently seen ones being
+    // reused first. When the view needs more pages than the budget, the map falls back to chunks.
+    void enableStaticCache(unsigned pageSize, size_t pageBudget);
+    void disableStaticCache();
+    bool isStaticCacheEnabled() const { return m_pageSize > 0; }
+    size_t getCachedPageCount() const { return m_pages.size(); }
+
     void render(sf::RenderWindow& w) override;
 
     sf::Vector2i getTileCoordinateInTexture(const TileType& tile);
@@ -44,6 +83,31 @@ public:
     int getHeight() const { return m_height; }
 
 private:
+    sf::Vector2f getLayerTileSize(int layerIndex) const;
+    TextureRegion getLayerTexture(int layerIndex);
+
+    bool findTileCoordinateInTexture(TileType tile, sf::Vector2i& coordinate) const;
+
+    void createChunks(Layer& layer);
+    void markAllChunksDirty();
+    void buildChunk(int layerIndex, int chunkRow, int chunkCol, const sf::IntRect& textureRegion);
+    void renderChunks(sf::RenderTarget& target, const sf::FloatRect& area);
+
+    struct Page
+    {
+        std::unique_ptr<sf::RenderTexture> target;
+        sf::Vector2i coordinate;
+        unsigned long long lastSeen = 0;
+        bool dirty = true;
+    };
+
+    sf::Vector2f getPixelSize() const;
+    bool renderPages(sf::RenderWindow& w, const sf::FloatRect& viewArea);
+    void refreshPages(const sf::IntRect& pageRange);
+    void renderPage(Page& page);
+    void markPagesDirty(const sf::FloatRect& area);
+    void markAllPagesDirty();
+
     TileType& getTile(int layerIndex, int row, int col) { return m_layers[layerIndex].tiles[row * m_width + col]; }
 
     const TileType& getTile(int layerIndex, int row, int col) const { return m_layers[layerIndex].tiles[row * m_width + col]; }
@@ -54,4 +118,12 @@ private:
     sf::Vector2f m_scale = { 1.0f, 1.0f };
     std::vector<TileType> m_tiles;
     std::vector<Layer> m_layers;
+
+    unsigned m_pageSize = 0;
+    size_t m_pageBudget = 0;
+    std::vector<Page> m_pages;
+    std::vector<Page*> m_visiblePages;
+    sf::IntRect m_visiblePageRange;
+    unsigned long long m_pageRefreshCount = 0;
+    bool m_pagesDirty = true;
 };
\ No newline at end of file
@@ -34,7 +34,7 @@ private:
     void changeHeroIcon(HeroIconState state);
 
 private:
-    Hero* m_hero;
+    GameObjectHandle m_hero;
     HeroIconState m_currentIconState;
 
     sf::Sprite m_healthBarBackground;
@@ -86,4 +86,40 @@ private:
     sf::Vector2f m_position;
     float m_scale;
     int m_lastScore;
+};
+
+
+class CollisionStatsUI : public CompositeGameObject
+{
+public:
+    CollisionStatsUI(const std::string& name = "CollisionStatsUI");
+    ~CollisionStatsUI() = default;
+
+    void initialize(float refreshInterval = 0.25f);
+    void update(const float& deltaTime) override;
+    void render(sf::RenderWindow& window) override;
+
+    void setVisible(bool visible);
+    bool isVisible() const;
+    void toggle();
+
+    void setPosition(const sf::Vector2f& position);
+
+    // Writes the profiler history to fileName, relative to the working directory.
+    void dumpCsv(const std::string& fileName = "collision_profile.csv");
+
+private:
+    void loadFont();
+    void updateStatsText();
+
+private:
+    sf::Text m_statsText;
+    sf::RectangleShape m_background;
+    sf::Font m_font;
+    sf::Vector2f m_position;
+    bool m_visible;
+    float m_refreshInterval;
+    float m_refreshTimer;
+    unsigned m_framesSinceRefresh;
+    unsigned long long m_allocationsAtRefresh;
 };
\ No newline at end of file
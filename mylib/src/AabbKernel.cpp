@@ -0,0 +1,151 @@
+#include "AabbKernel.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MINISTUDIO_AABB_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MINISTUDIO_AABB_SSE2
+#endif
+
+namespace
+{
+    inline bool overlapScalar(const AabbArray& bounds, int index, int other)
+    {
+        return bounds.minX[index] <= bounds.maxX[other] && bounds.maxX[index] >= bounds.minX[other] &&
+            bounds.minY[index] <= bounds.maxY[other] && bounds.maxY[index] >= bounds.minY[other];
+    }
+
+    inline size_t appendHits(int mask, const int* lanes, int laneCount, int* hits)
+    {
+        size_t hitCount = 0;
+        for (int lane = 0; lane < laneCount; ++lane)
+        {
+            if (mask & (1 << lane))
+                hits[hitCount++] = lanes[lane];
+        }
+        return hitCount;
+    }
+}
+
+size_t AabbKernel::overlapGather(const AabbArray& bounds, int index, const int* candidates, size_t count, int* hits)
+{
+    size_t hitCount = 0;
+    size_t idx = 0;
+
+#if defined(MINISTUDIO_AABB_AVX2)
+    const __m256 minX = _mm256_set1_ps(bounds.minX[index]);
+    const __m256 minY = _mm256_set1_ps(bounds.minY[index]);
+    const __m256 maxX = _mm256_set1_ps(bounds.maxX[index]);
+    const __m256 maxY = _mm256_set1_ps(bounds.maxY[index]);
+
+    for (; idx + 8 <= count; idx += 8)
+    {
+        const __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(candidates + idx));
+
+        __m256 overlap = _mm256_cmp_ps(minX, _mm256_i32gather_ps(bounds.maxX.data(), lanes, 4), _CMP_LE_OQ);
+        overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(maxX, _mm256_i32gather_ps(bounds.minX.data(), lanes, 4), _CMP_GE_OQ));
+        overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(minY, _mm256_i32gather_ps(bounds.maxY.data(), lanes, 4), _CMP_LE_OQ));
+        overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(maxY, _mm256_i32gather_ps(bounds.minY.data(), lanes, 4), _CMP_GE_OQ));
+
+        hitCount += appendHits(_mm256_movemask_ps(overlap), candidates + idx, 8, hits + hitCount);
+    }
+#elif defined(MINISTUDIO_AABB_SSE2)
+    const __m128 minX = _mm_set1_ps(bounds.minX[index]);
+    const __m128 minY = _mm_set1_ps(bounds.minY[index]);
+    const __m128 maxX = _mm_set1_ps(bounds.maxX[index]);
+    const __m128 maxY = _mm_set1_ps(bounds.maxY[index]);
+
+    for (; idx + 4 <= count; idx += 4)
+    {
+        const int* lanes = candidates + idx;
+
+        const __m128 otherMinX = _mm_setr_ps(bounds.minX[lanes[0]], bounds.minX[lanes[1]], bounds.minX[lanes[2]], bounds.minX[lanes[3]]);
+        const __m128 otherMinY = _mm_setr_ps(bounds.minY[lanes[0]], bounds.minY[lanes[1]], bounds.minY[lanes[2]], bounds.minY[lanes[3]]);
+        const __m128 otherMaxX = _mm_setr_ps(bounds.maxX[lanes[0]], bounds.maxX[lanes[1]], bounds.maxX[lanes[2]], bounds.maxX[lanes[3]]);
+        const __m128 otherMaxY = _mm_setr_ps(bounds.maxY[lanes[0]], bounds.maxY[lanes[1]], bounds.maxY[lanes[2]], bounds.maxY[lanes[3]]);
+
+        __m128 overlap = _mm_cmple_ps(minX, otherMaxX);
+        overlap = _mm_and_ps(overlap, _mm_cmpge_ps(maxX, otherMinX));
+        overlap = _mm_and_ps(overlap, _mm_cmple_ps(minY, otherMaxY));
+        overlap = _mm_and_ps(overlap, _mm_cmpge_ps(maxY, otherMinY));
+
+        hitCount += appendHits(_mm_movemask_ps(overlap), lanes, 4, hits + hitCount);
+    }
+#endif
+
+    for (; idx < count; ++idx)
+    {
+        if (overlapScalar(bounds, index, candidates[idx]))
+            hits[hitCount++] = candidates[idx];
+    }
+
+    return hitCount;
+}
+
+size_t AabbKernel::overlapRange(const AabbArray& bounds, int index, int begin, int end, int* hits)
+{
+    size_t hitCount = 0;
+    int other = begin;
+
+#if defined(MINISTUDIO_AABB_AVX2)
+    const __m256 minX = _mm256_set1_ps(bounds.minX[index]);
+    const __m256 minY = _mm256_set1_ps(bounds.minY[index]);
+    const __m256 maxX = _mm256_set1_ps(bounds.maxX[index]);
+    const __m256 maxY = _mm256_set1_ps(bounds.maxY[index]);
+
+    for (; other + 8 <= end; other += 8)
+    {
+        __m256 overlap = _mm256_cmp_ps(minX, _mm256_loadu_ps(bounds.maxX.data() + other), _CMP_LE_OQ);
+        overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(maxX, _mm256_loadu_ps(bounds.minX.data() + other), _CMP_GE_OQ));
+        overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(minY, _mm256_loadu_ps(bounds.maxY.data() + other), _CMP_LE_OQ));
+        overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(maxY, _mm256_loadu_ps(bounds.minY.data() + other), _CMP_GE_OQ));
+
+        int mask = _mm256_movemask_ps(overlap);
+        for (int lane = 0; mask; ++lane, mask >>= 1)
+        {
+            if (mask & 1)
+                hits[hitCount++] = other + lane;
+        }
+    }
+#elif defined(MINISTUDIO_AABB_SSE2)
+    const __m128 minX = _mm_set1_ps(bounds.minX[index]);
+    const __m128 minY = _mm_set1_ps(bounds.minY[index]);
+    const __m128 maxX = _mm_set1_ps(bounds.maxX[index]);
+    const __m128 maxY = _mm_set1_ps(bounds.maxY[index]);
+
+    for (; other + 4 <= end; other += 4)
+    {
+        __m128 overlap = _mm_cmple_ps(minX, _mm_loadu_ps(bounds.maxX.data() + other));
+        overlap = _mm_and_ps(overlap, _mm_cmpge_ps(maxX, _mm_loadu_ps(bounds.minX.data() + other)));
+        overlap = _mm_and_ps(overlap, _mm_cmple_ps(minY, _mm_loadu_ps(bounds.maxY.data() + other)));
+        overlap = _mm_and_ps(overlap, _mm_cmpge_ps(maxY, _mm_loadu_ps(bounds.minY.data() + other)));
+
+        int mask = _mm_movemask_ps(overlap);
+        for (int lane = 0; mask; ++lane, mask >>= 1)
+        {
+            if (mask & 1)
+                hits[hitCount++] = other + lane;
+        }
+    }
+#endif
+
+    for (; other < end; ++other)
+    {
+        if (overlapScalar(bounds, index, other))
+            hits[hitCount++] = other;
+    }
+
+    return hitCount;
+}
+
+const char* AabbKernel::getInstructionSet()
+{
+#if defined(MINISTUDIO_AABB_AVX2)
+    return "AVX2";
+#elif defined(MINISTUDIO_AABB_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,73 @@
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<unsigned long long> allocationCount(0);
+    std::atomic<unsigned long long> deallocationCount(0);
+}
+
+bool AllocationCounter::isEnabled()
+{
+#if defined(MINISTUDIO_COUNT_ALLOCATIONS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+unsigned long long AllocationCounter::getAllocationCount()
+{
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+unsigned long long AllocationCounter::getDeallocationCount()
+{
+    return deallocationCount.load(std::memory_order_relaxed);
+}
+
+#if defined(MINISTUDIO_COUNT_ALLOCATIONS)
+
+void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* memory = std::malloc(size ? size : 1))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    if (!memory)
+        return;
+
+    deallocationCount.fetch_add(1, std::memory_order_relaxed);
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    operator delete(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    operator delete(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    operator delete(memory);
+}
+
+#endif
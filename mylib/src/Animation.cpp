@@ -1,6 +1,7 @@
 #include "Animation.h"
 #include "TextureManager.h"
 #include "Composite.h"
+#include "SpriteBatch.h"
 
 Animation::Animation()
     : m_frameCount(1)
@@ -107,6 +108,15 @@ sf::IntRect Animation::getCurrentFrameRect() const
     return { x, y, m_frameSize.x, m_frameSize.y };
 }
 
+sf::IntRect Animation::getCurrentFrameRect(const sf::IntRect& region) const
+{
+    sf::IntRect frame = getCurrentFrameRect();
+    frame.left += region.left;
+    frame.top += region.top;
+
+    return frame;
+}
+
 
 
 // ANIMATION COMPONENT
@@ -134,15 +144,15 @@ void AnimationComponent::update(const float& deltaTime)
     auto& animation = m_animations[m_currentAnimation];
     animation.update(deltaTime);
 
-    m_sprite.setTextureRect(animation.getCurrentFrameRect());
+    m_sprite.setTextureRect(animation.getCurrentFrameRect(m_textureRegion));
 }
 
-void AnimationComponent::render(sf::RenderWindow& window)
+void AnimationComponent::render(sf::RenderWindow& /*window*/)
 {
     if (!m_playing || m_currentAnimation.empty())
         return;
 
-    window.draw(m_sprite);
+    SpriteBatch::getInstance().submit(m_sprite);
 }
 
 void AnimationComponent::addAnimation(const std::string& name, const Animation& animation)
@@ -164,11 +174,12 @@ void AnimationComponent::playAnimation(const std::string& name)
     m_currentAnimation = name;
     m_animations[name].reset();
 
-    sf::Texture* texture = TextureManager::getInstance().getTexture(m_animations[name].m_textureName);
-    if (texture)
+    TextureRegion region = TextureManager::getInstance().getRegion(m_animations[name].m_textureName);
+    if (region.texture)
     {
-        m_sprite.setTexture(*texture);
-        m_sprite.setTextureRect(m_animations[name].getCurrentFrameRect());
+        m_textureRegion = region.rect;
+        m_sprite.setTexture(*region.texture);
+        m_sprite.setTextureRect(m_animations[name].getCurrentFrameRect(m_textureRegion));
     }
 
     m_sprite.setPosition(currentPosition);
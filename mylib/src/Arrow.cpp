@@ -1,7 +1,9 @@
 #include "Arrow.h"
 #include "Animation.h"
 #include "Collision.h"
+#include "EntityLink.h"
 #include "Hero.h"
+#include "MotionSystem.h"
 #include "TextureManager.h"
 
 Arrow::Arrow(const std::string& name, int damage)
@@ -9,7 +11,9 @@ Arrow::Arrow(const std::string& name, int damage)
 {
     m_damage = damage;
     m_maxTimeBeforeDestroy = 3.0f;
-    addTag("Arrow");
+    addTag(Tag::Arrow);
+    setKind(Kind);
+    addComponent(std::make_shared<EntityLink>());
 }
 
 Arrow::~Arrow()
@@ -18,9 +22,30 @@ Arrow::~Arrow()
 
 void Arrow::initialize(const sf::Vector2f& pos, const sf::Vector2f& direction, float speed)
 {
-    auto square_renderer = std::make_shared<SquareRenderer>(8.0f, sf::Color::Transparent);
-    addComponent(square_renderer);
-    square_renderer->setPosition(pos);
+    auto hitbox = getComponent<Hitbox>();
+    if (hitbox)
+        hitbox->recycle();
+    else
+        createComponents();
+
+    getComponent<Transform>()->setPosition(pos);
+
+    auto animation_component = getComponent<AnimationComponent>();
+    animation_component->stopAnimation();
+    animation_component->playAnimation("arrow");
+
+    m_direction = direction;
+    m_speed = speed;
+    m_TimeBeforeDestroy = 0.0f;
+
+    getComponent<EntityLink>()->add<Motion>(getComponent<Transform>(), m_direction * m_speed);
+
+    updateAnimation();
+}
+
+void Arrow::createComponents()
+{
+    addComponent(std::make_shared<SquareRenderer>(8.0f, sf::Color::Transparent));
 
     auto animation_component = std::make_shared<AnimationComponent>();
     addComponent(animation_component);
@@ -30,25 +55,27 @@ void Arrow::initialize(const sf::Vector2f& pos, const sf::Vector2f& direction, f
     arrow_animation.setFrameSize(frameSize);
     arrow_animation.setStartPosition(sf::Vector2i(0, 0));
     animation_component->addAnimation("arrow", arrow_animation);
-    animation_component->playAnimation("arrow");
     animation_component->setScale(sf::Vector2f(4.f, 4.f));
 
     auto hitbox = std::make_shared<Hitbox>(sf::Vector2f(16.0f, 8.0f));
     hitbox->setDebugDraw(false);
+    hitbox->setCollisionLayer(CollisionLayer::Projectile);
+    hitbox->setCollisionMask(CollisionLayer::Hero);
+    hitbox->setFastMoving(true);
     addComponent(hitbox);
 
     hitbox->setEnterCollision([this](Hitbox* self, Hitbox* other) 
         {
         auto object = other->getOwner();
-        if (object && object->hasTag("Hero")) 
+        if (object && object->hasTag(Tag::Hero)) 
         {
-            auto hero = dynamic_cast<Hero*>(object);
+            auto hero = object->as<Hero>();
             if (hero) 
             {
-                auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-                if (square_renderer) 
+                auto transform = getComponent<Transform>();
+                if (transform) 
                 {
-                    sf::Vector2f arrowPos = square_renderer->getPosition();
+                    sf::Vector2f arrowPos = transform->getPosition();
                     hero->takeDamage(m_damage, arrowPos);
                 }
                 else
@@ -56,28 +83,21 @@ void Arrow::initialize(const sf::Vector2f& pos, const sf::Vector2f& direction, f
             }
         }
         });
-
-    m_direction = direction;
-    m_speed = speed;
-
-    updateAnimation();
 }
 
 void Arrow::update(const float& deltaTime)
 {
-    auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-    if (square_renderer)
-    {
-        sf::Vector2f pos = square_renderer->getPosition();
-        pos += m_direction * m_speed * deltaTime;
-        square_renderer->setPosition(pos);
-
-        updateAnimation();
-    }
+    // MotionSystem has already moved the arrow this step.
+    updateAnimation();
 
     IProjectile::update(deltaTime);
 }
 
+void Arrow::deactivate()
+{
+    getComponent<EntityLink>()->remove<Motion>();
+}
+
 int Arrow::getDamage() const
 {
     return m_damage;
@@ -12,9 +12,9 @@ sf::Vector2f CameraTargetAdapter::getPosition() const
     if (!m_owner)
         return { 0.f, 0.f };
 
-    auto* square_renderer = static_cast<SquareRenderer*>(m_owner->getComponent("SquareRenderer"));
-    if (square_renderer)
-        return square_renderer->getPosition();
+    auto* transform = m_owner->getComponent<Transform>();
+    if (transform)
+        return transform->getPosition();
 
     return { 0.f, 0.f };
 }
@@ -24,7 +24,7 @@ sf::Vector2f CameraTargetAdapter::getVelocity() const
     if (!m_owner)
         return { 0.f, 0.f };
 
-    auto* controller = static_cast<PlayerController*>(m_owner->getComponent("PlayerController"));
+    auto* controller = m_owner->getComponent<PlayerController>();
     if (controller)
     {
         sf::Vector2f velocity(0.f, 0.f);
@@ -1,12 +1,24 @@
 #include "Collision.h"
+#include "CollisionWorld.h"
 #include "Composite.h"
-#include <algorithm>
-#include <iostream>
 
 Hitbox::Hitbox(const sf::Vector2f& size)
 	: Component("Hitbox")
 	, m_size(size)
 	, m_offset(0.0f, 0.0f)
+	, m_layer(CollisionLayer::Default)
+	, m_mask(CollisionLayer::All)
+	, m_fastMoving(false)
+	, m_hasPreviousCenter(false)
+	, m_static(false)
+	, m_sleeping(false)
+	, m_autoSleep(true)
+	, m_idleSteps(0)
+	, m_hasLastBounds(false)
+	, m_lastBounds{ 0.0f, 0.0f, 0.0f, 0.0f }
+	, m_restEligibleStep(0)
+	, m_restingStep(0)
+	, m_restingSlot(-1)
 	, m_debugDraw(false)
 {
 	m_debugShape.setSize(m_size);
@@ -14,10 +26,13 @@ Hitbox::Hitbox(const sf::Vector2f& size)
 	m_debugShape.setFillColor(sf::Color::Transparent);
 	m_debugShape.setOutlineColor(sf::Color::Red);
 	m_debugShape.setOutlineThickness(1.0f);
+
+	m_handle = CollisionWorld::getInstance().registerHitbox(this);
 }
 
 Hitbox::~Hitbox()
 {
+	CollisionWorld::getInstance().unregisterHitbox(m_handle);
 }
 
 void Hitbox::initialize()
@@ -25,23 +40,19 @@ void Hitbox::initialize()
 	Component::initialize();
 }
 
-void Hitbox::update(const float& deltaTime)
+void Hitbox::render(sf::RenderWindow& window)
 {
-	if (m_owner)
+	if (!m_debugDraw || !m_owner)
+		return;
+
+	auto transform = m_owner->getComponent<Transform>();
+	if (transform)
 	{
-		auto square_renderer = static_cast<SquareRenderer*>(m_owner->getComponent("SquareRenderer"));
-		if (square_renderer)
-		{
-			sf::Vector2f pos = square_renderer->getPosition() + m_offset;
-			m_debugShape.setPosition(pos);
-		}
+		sf::Vector2f pos = transform->getPosition() + m_offset;
+		m_debugShape.setPosition(pos);
 	}
-}
 
-void Hitbox::render(sf::RenderWindow& window)
-{
-	if (m_debugDraw)
-		window.draw(m_debugShape);
+	window.draw(m_debugShape);
 }
 
 bool Hitbox::checkCollision(const Hitbox* other) const
@@ -78,6 +89,97 @@ sf::Vector2f Hitbox::getOffset() const
 	return m_offset;
 }
 
+void Hitbox::setCollisionLayer(std::uint32_t layer)
+{
+	m_layer = layer;
+	wake();
+}
+
+std::uint32_t Hitbox::getCollisionLayer() const
+{
+	return m_layer;
+}
+
+void Hitbox::setCollisionMask(std::uint32_t mask)
+{
+	m_mask = mask;
+	wake();
+}
+
+std::uint32_t Hitbox::getCollisionMask() const
+{
+	return m_mask;
+}
+
+bool Hitbox::canCollideWith(const Hitbox* other) const
+{
+	return (m_layer & other->m_mask) && (other->m_layer & m_mask);
+}
+
+void Hitbox::setFastMoving(bool fastMoving)
+{
+	m_fastMoving = fastMoving;
+	resetSweep();
+}
+
+bool Hitbox::isFastMoving() const
+{
+	return m_fastMoving;
+}
+
+void Hitbox::resetSweep()
+{
+	m_hasPreviousCenter = false;
+}
+
+void Hitbox::setStatic(bool isStatic)
+{
+	m_static = isStatic;
+	wake();
+}
+
+bool Hitbox::isStatic() const
+{
+	return m_static;
+}
+
+void Hitbox::setAutoSleep(bool autoSleep)
+{
+	m_autoSleep = autoSleep;
+	if (!m_autoSleep)
+		wake();
+}
+
+void Hitbox::sleep()
+{
+	m_sleeping = true;
+}
+
+void Hitbox::wake()
+{
+	m_sleeping = false;
+	m_idleSteps = 0;
+
+	// Leaves the resting set for at least one step, so the hitbox is tested against everything
+	// before it can rest again.
+	m_restEligibleStep = 0;
+}
+
+bool Hitbox::isSleeping() const
+{
+	return m_sleeping;
+}
+
+void Hitbox::recycle()
+{
+	CollisionWorld::getInstance().unregisterHitbox(m_handle);
+	m_handle = CollisionWorld::getInstance().registerHitbox(this);
+
+	m_hasLastBounds = false;
+	resetSweep();
+	wake();
+}
+
 void Hitbox::setEnterCollision(CollisionEvents events)
 {
 	m_enterCollision = events;
@@ -108,131 +210,31 @@ void Hitbox::setDebugDraw(bool debugDraw)
 	m_debugDraw = debugDraw;
 }
 
+HitboxHandle Hitbox::getHandle() const
+{
+	return m_handle;
+}
+
 void Hitbox::resolveCollisions(const std::vector<std::shared_ptr<CompositeGameObject>>& gameObjects)
 {
-    std::vector<Hitbox*> hitboxes;
-    std::unordered_map<Hitbox*, bool> hitboxValidity;
-
-    for (const auto& gameObject : gameObjects)
-    {
-        if (!gameObject) continue;
-
-        auto hitbox = static_cast<Hitbox*>(gameObject->getComponent("Hitbox"));
-        if (hitbox)
-        {
-            hitboxes.push_back(hitbox);
-            hitboxValidity[hitbox] = true;
-
-            for (auto iterator = hitbox->m_currentCollisions.begin(); iterator != hitbox->m_currentCollisions.end();)
-            {
-                Hitbox* target = *iterator;
-                if (!target || hitboxValidity.find(target) == hitboxValidity.end())
-                    iterator = hitbox->m_currentCollisions.erase(iterator);
-                else
-                    ++iterator;
-            }
-        }
-    }
-
-    for (size_t idx = 0; idx < hitboxes.size(); ++idx)
-    {
-        Hitbox* hitboxA = hitboxes[idx];
-        std::vector<Hitbox*> currentCollisions;
-
-        for (size_t jdx = idx + 1; jdx < hitboxes.size(); ++jdx)
-        {
-            Hitbox* hitboxB = hitboxes[jdx];
-
-            if (hitboxA->checkCollision(hitboxB))
-            {
-                currentCollisions.push_back(hitboxB);
-
-                auto iteratorA = std::find(hitboxA->m_currentCollisions.begin(),
-                    hitboxA->m_currentCollisions.end(), hitboxB);
-
-                if (iteratorA == hitboxA->m_currentCollisions.end())
-                {
-                    if (hitboxA->m_enterCollision)
-                    {
-                        try
-                        {
-                            hitboxA->enterCollision(hitboxB);
-                        }
-                        catch (...)
-                        {
-                            hitboxA->m_enterCollision = nullptr;
-                            std::cerr << "Error in enterCollision" << std::endl;
-                        }
-                    }
-
-                    if (hitboxB->m_enterCollision)
-                    {
-                        try 
-                        {
-                            hitboxB->enterCollision(hitboxA);
-                        }
-                        catch (...) 
-                        {
-                            hitboxB->m_enterCollision = nullptr;
-                            std::cerr << "Error in enterCollision" << std::endl;
-                        }
-                    }
-                }
-            }
-        }
-
-        for (auto iterator = hitboxA->m_currentCollisions.begin(); iterator != hitboxA->m_currentCollisions.end();)
-        {
-            Hitbox* finishedCollision = *iterator;
-
-            if (std::find(currentCollisions.begin(), currentCollisions.end(), finishedCollision) == currentCollisions.end())
-            {
-                if (hitboxA->m_exitCollision)
-                {
-                    try 
-                    {
-                        hitboxA->exitCollision(finishedCollision);
-                    }
-                    catch (...) 
-                    {
-                        hitboxA->m_exitCollision = nullptr;
-                        std::cerr << "Error in exitCollision" << std::endl;
-                    }
-                }
-
-                if (hitboxValidity.find(finishedCollision) != hitboxValidity.end() && finishedCollision->m_exitCollision)
-                {
-                    try 
-                    {
-                        finishedCollision->exitCollision(hitboxA);
-                    }
-                    catch (...) 
-                    {
-                        finishedCollision->m_exitCollision = nullptr;
-                        std::cerr << "Error in exitCollision" << std::endl;
-                    }
-                }
-
-                iterator = hitboxA->m_currentCollisions.erase(iterator);
-            }
-            else
-                ++iterator;
-        }
-
-        hitboxA->m_currentCollisions = currentCollisions;
-    }
+	CollisionWorld::getInstance().resolveCollisions(gameObjects);
+}
+
+size_t Hitbox::getPairTestCount()
+{
+	return CollisionWorld::getInstance().getPairTestCount();
 }
 
 void Hitbox::getBounds(float& minX, float& minY, float& maxX, float& maxY) const
 {
-	auto square_renderer = static_cast<SquareRenderer*>(m_owner->getComponent("SquareRenderer"));
-	if (!square_renderer)
+	auto transform = m_owner->getComponent<Transform>();
+	if (!transform)
 	{
 		minX = minY = maxX = maxY = 0.0f;
 		return;
 	}
 
-	sf::Vector2f pos = square_renderer->getPosition() + m_offset;
+	sf::Vector2f pos = transform->getPosition() + m_offset;
 
 	minX = pos.x - m_size.x / 2.0f;
 	minY = pos.y - m_size.y / 2.0f;
@@ -0,0 +1,141 @@
+#include "CollisionProfiler.h"
+
+#include <algorithm>
+#include <fstream>
+
+CollisionProfiler::CollisionProfiler()
+    : m_history(600)
+    , m_next(0)
+    , m_count(0)
+    , m_step(0)
+{
+}
+
+void CollisionProfiler::setHistorySize(size_t historySize)
+{
+    m_history.assign(std::max<size_t>(1, historySize), CollisionStepStats());
+    m_next = 0;
+    m_count = 0;
+}
+
+void CollisionProfiler::record(CollisionStepStats stats)
+{
+    stats.step = m_step++;
+
+    m_history[m_next] = stats;
+    m_next = (m_next + 1) % m_history.size();
+    m_count = std::min(m_count + 1, m_history.size());
+}
+
+void CollisionProfiler::clear()
+{
+    m_next = 0;
+    m_count = 0;
+}
+
+const CollisionStepStats& CollisionProfiler::getRecorded(size_t age) const
+{
+    return m_history[(m_next + m_history.size() - 1 - age) % m_history.size()];
+}
+
+const CollisionStepStats& CollisionProfiler::getLast() const
+{
+    static const CollisionStepStats empty;
+    return m_count ? getRecorded(0) : empty;
+}
+
+CollisionStepStats CollisionProfiler::getAverage() const
+{
+    CollisionStepStats average;
+    if (!m_count)
+        return average;
+
+    for (size_t age = 0; age < m_count; ++age)
+    {
+        const CollisionStepStats& stats = getRecorded(age);
+
+        average.hitboxes += stats.hitboxes;
+        average.resting += stats.resting;
+        average.candidates += stats.candidates;
+        average.narrowTests += stats.narrowTests;
+        average.contacts += stats.contacts;
+        average.enters += stats.enters;
+        average.exits += stats.exits;
+        average.gatherMs += stats.gatherMs;
+        average.broadphaseMs += stats.broadphaseMs;
+        average.narrowMs += stats.narrowMs;
+        average.dispatchMs += stats.dispatchMs;
+    }
+
+    average.step = getLast().step;
+    average.hitboxes /= m_count;
+    average.resting /= m_count;
+    average.candidates /= m_count;
+    average.narrowTests /= m_count;
+    average.contacts /= m_count;
+    average.enters /= m_count;
+    average.exits /= m_count;
+    average.gatherMs /= m_count;
+    average.broadphaseMs /= m_count;
+    average.narrowMs /= m_count;
+    average.dispatchMs /= m_count;
+
+    return average;
+}
+
+CollisionStepStats CollisionProfiler::getPeak() const
+{
+    CollisionStepStats peak;
+
+    for (size_t age = 0; age < m_count; ++age)
+    {
+        const CollisionStepStats& stats = getRecorded(age);
+
+        peak.hitboxes = std::max(peak.hitboxes, stats.hitboxes);
+        peak.resting = std::max(peak.resting, stats.resting);
+        peak.candidates = std::max(peak.candidates, stats.candidates);
+        peak.narrowTests = std::max(peak.narrowTests, stats.narrowTests);
+        peak.contacts = std::max(peak.contacts, stats.contacts);
+        peak.enters = std::max(peak.enters, stats.enters);
+        peak.exits = std::max(peak.exits, stats.exits);
+        peak.gatherMs = std::max(peak.gatherMs, stats.gatherMs);
+        peak.broadphaseMs = std::max(peak.broadphaseMs, stats.broadphaseMs);
+        peak.narrowMs = std::max(peak.narrowMs, stats.narrowMs);
+        peak.dispatchMs = std::max(peak.dispatchMs, stats.dispatchMs);
+        peak.peakTotalMs = std::max(peak.peakTotalMs, stats.totalMs());
+    }
+
+    peak.step = getLast().step;
+    return peak;
+}
+
+bool CollisionProfiler::dumpCsv(const std::string& path) const
+{
+    std::ofstream file(path);
+    if (!file)
+        return false;
+
+    file << "step,hitboxes,resting,candidates,narrow_tests,contacts,enters,exits,"
+        << "gather_ms,broadphase_ms,narrow_ms,dispatch_ms,total_ms\n";
+
+    for (size_t age = m_count; age > 0; --age)
+    {
+        const CollisionStepStats& stats = getRecorded(age - 1);
+
+        file << stats.step << ','
+            << stats.hitboxes << ','
+            << stats.resting << ','
+            << stats.candidates << ','
+            << stats.narrowTests << ','
+            << stats.contacts << ','
+            << stats.enters << ','
+            << stats.exits << ','
+            << stats.gatherMs << ','
+            << stats.broadphaseMs << ','
+            << stats.narrowMs << ','
+            << stats.dispatchMs << ','
+            << stats.totalMs() << '\n';
+    }
+
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,457 @@
+#include "CollisionWorld.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+#include "AabbKernel.h"
+#include "Collision.h"
+#include "CollisionProfiler.h"
+#include "Composite.h"
+#include "JobPool.h"
+#include "Map.h"
+
+namespace
+{
+    // Slab test of the segment start + t * displacement, t in [0, 1], against the box centred on
+    // the origin with the given half extents.
+    bool segmentHitsBox(const sf::Vector2f& start, const sf::Vector2f& displacement, const sf::Vector2f& halfExtents)
+    {
+        float tMin = 0.0f;
+        float tMax = 1.0f;
+
+        const float starts[2] = { start.x, start.y };
+        const float deltas[2] = { displacement.x, displacement.y };
+        const float extents[2] = { halfExtents.x, halfExtents.y };
+
+        for (int axis = 0; axis < 2; ++axis)
+        {
+            if (std::abs(deltas[axis]) < 1e-6f)
+            {
+                if (std::abs(starts[axis]) > extents[axis])
+                    return false;
+                continue;
+            }
+
+            float tEnter = (-extents[axis] - starts[axis]) / deltas[axis];
+            float tExit = (extents[axis] - starts[axis]) / deltas[axis];
+            if (tEnter > tExit)
+                std::swap(tEnter, tExit);
+
+            tMin = std::max(tMin, tEnter);
+            tMax = std::min(tMax, tExit);
+            if (tMin > tMax)
+                return false;
+        }
+
+        return true;
+    }
+
+    // Steps a hitbox has to stay still before it falls asleep on its own.
+    const int sleepAfterSteps = 30;
+
+    using Clock = std::chrono::steady_clock;
+
+    double elapsedMs(Clock::time_point& start)
+    {
+        Clock::time_point now = Clock::now();
+        double elapsed = std::chrono::duration<double, std::milli>(now - start).count();
+        start = now;
+        return elapsed;
+    }
+}
+
+CollisionWorld::CollisionWorld()
+    : m_restingDirty(true)
+    , m_step(1)
+    , m_pairTestCount(0)
+{
+}
+
+HitboxHandle CollisionWorld::registerHitbox(Hitbox* hitbox)
+{
+    return m_hitboxSlots.insert(hitbox);
+}
+
+void CollisionWorld::unregisterHitbox(HitboxHandle handle)
+{
+    m_hitboxSlots.erase(handle);
+}
+
+Hitbox* CollisionWorld::resolve(HitboxHandle handle) const
+{
+    return m_hitboxSlots.resolve(handle);
+}
+
+void CollisionWorld::gatherHitboxes(const std::vector<std::shared_ptr<CompositeGameObject>>& gameObjects)
+{
+    m_hitboxes.clear();
+    m_handles.clear();
+    m_layers.clear();
+    m_masks.clear();
+    m_fastFlags.clear();
+    m_centers.clear();
+    m_halfSizes.clear();
+    m_displacements.clear();
+    m_bounds.clear();
+    m_restingNow.clear();
+
+    ++m_step;
+
+    for (const auto& gameObject : gameObjects)
+    {
+        if (!gameObject)
+            continue;
+
+        auto hitbox = gameObject->getComponent<Hitbox>();
+        if (!hitbox)
+            continue;
+
+        float minX, minY, maxX, maxY;
+        hitbox->getBounds(minX, minY, maxX, maxY);
+
+        bool moved = !hitbox->m_hasLastBounds
+            || minX != hitbox->m_lastBounds[0] || minY != hitbox->m_lastBounds[1]
+            || maxX != hitbox->m_lastBounds[2] || maxY != hitbox->m_lastBounds[3];
+
+        hitbox->m_lastBounds[0] = minX;
+        hitbox->m_lastBounds[1] = minY;
+        hitbox->m_lastBounds[2] = maxX;
+        hitbox->m_lastBounds[3] = maxY;
+        hitbox->m_hasLastBounds = true;
+
+        if (moved)
+            hitbox->wake();
+        else if (hitbox->m_idleSteps < sleepAfterSteps)
+            ++hitbox->m_idleSteps;
+
+        if (hitbox->m_autoSleep && !hitbox->m_static && !hitbox->m_fastMoving && hitbox->m_idleSteps >= sleepAfterSteps)
+            hitbox->m_sleeping = true;
+
+        // A hitbox only rests after a full step of being still and static or asleep. That step
+        // tested it against every other hitbox, so the contacts carried over from it are complete.
+        bool restEligible = (hitbox->m_static || hitbox->m_sleeping) && !moved;
+        bool resting = restEligible && hitbox->m_restEligibleStep + 1 == m_step;
+        if (restEligible)
+            hitbox->m_restEligibleStep = m_step;
+
+        if (resting)
+        {
+            hitbox->m_restingStep = m_step;
+            m_restingNow.push_back(hitbox);
+
+            if (hitbox->m_restingSlot < 0)
+                m_restingDirty = true;
+            continue;
+        }
+
+        sf::Vector2f center((minX + maxX) / 2.0f, (minY + maxY) / 2.0f);
+        sf::Vector2f halfSize((maxX - minX) / 2.0f, (maxY - minY) / 2.0f);
+        sf::Vector2f displacement(0.0f, 0.0f);
+
+        // Fast hitboxes enter the broadphase with the box swept since the previous step, and
+        // their pairs are confirmed by sweptOverlap instead of the end positions alone.
+        if (hitbox->m_fastMoving)
+        {
+            if (hitbox->m_hasPreviousCenter)
+                displacement = center - hitbox->m_previousCenter;
+
+            hitbox->m_previousCenter = center;
+            hitbox->m_hasPreviousCenter = true;
+
+            minX = std::min(minX, minX - displacement.x);
+            minY = std::min(minY, minY - displacement.y);
+            maxX = std::max(maxX, maxX - displacement.x);
+            maxY = std::max(maxY, maxY - displacement.y);
+        }
+
+        m_hitboxes.push_back(hitbox);
+        m_handles.push_back(hitbox->m_handle);
+        m_layers.push_back(hitbox->m_layer);
+        m_masks.push_back(hitbox->m_mask);
+        m_fastFlags.push_back(hitbox->m_fastMoving ? 1 : 0);
+        m_centers.push_back(center);
+        m_halfSizes.push_back(halfSize);
+        m_displacements.push_back(displacement);
+        m_bounds.push_back(minX, minY, maxX, maxY);
+    }
+
+    if (m_restingNow.size() != m_resting.hitboxes.size())
+        m_restingDirty = true;
+}
+
+void CollisionWorld::rebuildRestingSet()
+{
+    for (HitboxHandle handle : m_resting.handles)
+    {
+        if (Hitbox* hitbox = resolve(handle))
+            hitbox->m_restingSlot = -1;
+    }
+
+    m_resting.hitboxes.clear();
+    m_resting.handles.clear();
+    m_resting.layers.clear();
+    m_resting.masks.clear();
+    m_resting.centers.clear();
+    m_resting.halfSizes.clear();
+    m_resting.bounds.clear();
+
+    for (Hitbox* hitbox : m_restingNow)
+    {
+        const float* bounds = hitbox->m_lastBounds;
+
+        hitbox->m_restingSlot = static_cast<int>(m_resting.hitboxes.size());
+
+        m_resting.hitboxes.push_back(hitbox);
+        m_resting.handles.push_back(hitbox->m_handle);
+        m_resting.layers.push_back(hitbox->m_layer);
+        m_resting.masks.push_back(hitbox->m_mask);
+        m_resting.centers.emplace_back((bounds[0] + bounds[2]) / 2.0f, (bounds[1] + bounds[3]) / 2.0f);
+        m_resting.halfSizes.emplace_back((bounds[2] - bounds[0]) / 2.0f, (bounds[3] - bounds[1]) / 2.0f);
+        m_resting.bounds.push_back(bounds[0], bounds[1], bounds[2], bounds[3]);
+    }
+
+    m_resting.grid.setWorldBounds(WorldLimits::getBounds());
+    m_resting.grid.build(m_resting.bounds, m_resting.layers, m_resting.masks);
+
+    m_restingDirty = false;
+}
+
+void CollisionWorld::findRestingPairs(size_t activeCount)
+{
+    if (m_resting.hitboxes.empty())
+        return;
+
+    for (size_t index = 0; index < activeCount; ++index)
+    {
+        if (!m_layers[index] || !m_masks[index])
+            continue;
+
+        m_restingQuery.clear();
+        m_resting.grid.query(m_bounds.minX[index], m_bounds.minY[index], m_bounds.maxX[index], m_bounds.maxY[index],
+            m_layers[index], m_masks[index], m_restingQuery);
+
+        for (int slot : m_restingQuery)
+            m_candidatePairs.emplace_back(static_cast<int>(index), static_cast<int>(activeCount) + slot);
+    }
+
+    std::sort(m_candidatePairs.begin(), m_candidatePairs.end());
+}
+
+void CollisionWorld::appendRestingSet()
+{
+    for (size_t slot = 0; slot < m_resting.hitboxes.size(); ++slot)
+    {
+        m_hitboxes.push_back(m_resting.hitboxes[slot]);
+        m_handles.push_back(m_resting.handles[slot]);
+        m_layers.push_back(m_resting.layers[slot]);
+        m_masks.push_back(m_resting.masks[slot]);
+        m_fastFlags.push_back(0);
+        m_centers.push_back(m_resting.centers[slot]);
+        m_halfSizes.push_back(m_resting.halfSizes[slot]);
+        m_displacements.emplace_back(0.0f, 0.0f);
+        m_bounds.push_back(m_resting.bounds.minX[slot], m_resting.bounds.minY[slot], m_resting.bounds.maxX[slot], m_resting.bounds.maxY[slot]);
+    }
+}
+
+void CollisionWorld::keepRestingContacts()
+{
+    for (const auto& contact : m_contacts.getContacts())
+    {
+        Hitbox* first = resolve(contact.first);
+        Hitbox* second = resolve(contact.second);
+
+        if (first && second && first->m_restingStep == m_step && second->m_restingStep == m_step)
+            m_contacts.add(contact.first, contact.second);
+    }
+}
+
+void CollisionWorld::resolveCollisions(const std::vector<std::shared_ptr<CompositeGameObject>>& gameObjects)
+{
+    CollisionStepStats stats;
+    Clock::time_point phaseStart = Clock::now();
+
+    gatherHitboxes(gameObjects);
+
+    if (m_resting.grid.getWorldBounds() != WorldLimits::getBounds())
+        m_restingDirty = true;
+    if (m_restingDirty)
+        rebuildRestingSet();
+
+    const size_t activeCount = m_bounds.size();
+    stats.hitboxes = activeCount + m_resting.hitboxes.size();
+    stats.resting = m_resting.hitboxes.size();
+    stats.gatherMs = elapsedMs(phaseStart);
+
+    m_broadphase.setWorldBounds(WorldLimits::getBounds());
+    m_broadphase.build(m_bounds, m_layers, m_masks);
+    m_broadphase.findPairs(m_candidatePairs);
+    findRestingPairs(activeCount);
+    m_pairTestCount = m_candidatePairs.size();
+
+    // Resting hitboxes take the ids following the active ones, so the narrow phase sees a single
+    // set of arrays.
+    appendRestingSet();
+
+    buildBatches();
+    stats.candidates = m_pairTestCount;
+    stats.broadphaseMs = elapsedMs(phaseStart);
+
+    // Batches are tested in parallel into per-worker buffers. Events are only dispatched once the
+    // buffers are merged back here; ContactTable sorts the merged set, so the dispatch order does
+    // not depend on how the work was split.
+    m_workers.resize(JobPool::getInstance().getWorkerCount());
+    for (auto& worker : m_workers)
+    {
+        worker.contacts.clear();
+        worker.tests = 0;
+    }
+
+    JobPool::getInstance().parallelFor(m_batches.size(), 16,
+        [this](size_t begin, size_t end, unsigned worker)
+        {
+            testBatches(begin, end, m_workers[worker]);
+        });
+
+    for (const auto& worker : m_workers)
+        stats.narrowTests += worker.tests;
+    stats.narrowMs = elapsedMs(phaseStart);
+
+    m_contacts.beginStep();
+    for (const auto& worker : m_workers)
+    {
+        for (const auto& contact : worker.contacts)
+            m_contacts.add(contact.first, contact.second);
+    }
+    keepRestingContacts();
+
+    m_contacts.commit(
+        [this, &stats](HitboxHandle first, HitboxHandle second)
+        {
+            ++stats.enters;
+            dispatchEnter(first, second);
+            dispatchEnter(second, first);
+        },
+        [this, &stats](HitboxHandle first, HitboxHandle second)
+        {
+            ++stats.exits;
+            dispatchExit(first, second);
+            dispatchExit(second, first);
+        });
+
+    stats.contacts = m_contacts.getContactCount();
+    stats.dispatchMs = elapsedMs(phaseStart);
+
+    CollisionProfiler::getInstance().record(stats);
+}
+
+void CollisionWorld::buildBatches()
+{
+    m_batches.clear();
+    m_batchCandidates.clear();
+
+    // Candidate pairs come sorted by their first id, so each run is one box against a batch.
+    for (size_t begin = 0; begin < m_candidatePairs.size();)
+    {
+        Batch batch;
+        batch.index = m_candidatePairs[begin].first;
+        batch.begin = m_batchCandidates.size();
+
+        size_t end = begin;
+        for (; end < m_candidatePairs.size() && m_candidatePairs[end].first == batch.index; ++end)
+            m_batchCandidates.push_back(m_candidatePairs[end].second);
+
+        batch.end = m_batchCandidates.size();
+        m_batches.push_back(batch);
+
+        begin = end;
+    }
+}
+
+void CollisionWorld::testBatches(size_t firstBatch, size_t lastBatch, WorkerBuffers& buffers) const
+{
+    for (size_t batchIndex = firstBatch; batchIndex < lastBatch; ++batchIndex)
+    {
+        const Batch& batch = m_batches[batchIndex];
+        const size_t count = batch.end - batch.begin;
+
+        buffers.hits.resize(count);
+        size_t hitCount = AabbKernel::overlapGather(m_bounds, batch.index, m_batchCandidates.data() + batch.begin, count, buffers.hits.data());
+        buffers.tests += count;
+
+        for (size_t hit = 0; hit < hitCount; ++hit)
+        {
+            int other = buffers.hits[hit];
+            if (m_fastFlags[batch.index] || m_fastFlags[other])
+            {
+                ++buffers.tests;
+                if (!sweptOverlap(batch.index, other))
+                    continue;
+            }
+
+            buffers.contacts.emplace_back(m_handles[batch.index], m_handles[other]);
+        }
+    }
+}
+
+bool CollisionWorld::sweptOverlap(int first, int second) const
+{
+    // Work in the second box's frame: the first box's centre moves along the relative
+    // displacement, and the pair overlaps wherever it lies within the summed half extents.
+    sf::Vector2f relativeDisplacement = m_displacements[first] - m_displacements[second];
+    sf::Vector2f start = (m_centers[first] - m_displacements[first]) - (m_centers[second] - m_displacements[second]);
+
+    return segmentHitsBox(start, relativeDisplacement, m_halfSizes[first] + m_halfSizes[second]);
+}
+
+void CollisionWorld::dispatchEnter(HitboxHandle self, HitboxHandle other)
+{
+    Hitbox* selfHitbox = resolve(self);
+    Hitbox* otherHitbox = resolve(other);
+    if (!selfHitbox || !otherHitbox)
+        return;
+
+    try
+    {
+        selfHitbox->enterCollision(otherHitbox);
+    }
+    catch (...)
+    {
+        selfHitbox->setEnterCollision(nullptr);
+        std::cerr << "Error in enterCollision" << std::endl;
+    }
+}
+
+void CollisionWorld::dispatchExit(HitboxHandle self, HitboxHandle other)
+{
+    Hitbox* selfHitbox = resolve(self);
+    Hitbox* otherHitbox = resolve(other);
+    if (!selfHitbox || !otherHitbox)
+        return;
+
+    try
+    {
+        selfHitbox->exitCollision(otherHitbox);
+    }
+    catch (...)
+    {
+        selfHitbox->setExitCollision(nullptr);
+        std::cerr << "Error in exitCollision" << std::endl;
+    }
+}
+
+size_t CollisionWorld::getPairTestCount() const
+{
+    return m_pairTestCount;
+}
+
+size_t CollisionWorld::getContactCount() const
+{
+    return m_contacts.getContactCount();
+}
+
+size_t CollisionWorld::getRestingCount() const
+{
+    return m_resting.hitboxes.size();
+}
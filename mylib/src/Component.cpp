@@ -10,7 +10,9 @@
 #include "TextureManager.h"
 
 Component::Component(const std::string& name)
-	: m_name(name)
+	: m_owner(nullptr)
+	, m_name(name)
+	, m_priority(0)
 {
 }
 
@@ -40,6 +42,19 @@ CompositeGameObject* Component::getOwner() const
 	return m_owner;
 }
 
+void Component::setPriority(int priority)
+{
+	m_priority = priority;
+
+	if (m_owner)
+		m_owner->markDispatchDirty();
+}
+
+int Component::getPriority() const
+{
+	return m_priority;
+}
+
 std::string Component::getName() const
 {
 	return m_name;
@@ -52,6 +67,12 @@ void Component::setName(const std::string& name)
 
 
 // PLAYER RENDER
+Transform::Transform(const sf::Vector2f& position)
+	: Component("Transform")
+	, m_data{ position, sf::Vector2f(0.0f, 0.0f) }
+{
+}
+
 SquareRenderer::SquareRenderer(float size, const sf::Color& color)
     : Component("SquareRenderer")
     , m_size(size)
@@ -64,10 +85,17 @@ void SquareRenderer::initialize()
     m_shape.setSize(sf::Vector2f(m_size, m_size));
     m_shape.setFillColor(m_color);
     m_shape.setOrigin(m_size / 2.0f, m_size / 2.0f);
+
+    if (m_owner && !m_owner->getComponent<Transform>())
+        m_owner->addComponent(std::make_shared<Transform>(m_shape.getPosition()));
 }
 
 void SquareRenderer::render(sf::RenderWindow& window)
 {
+    if (m_color.a == 0)
+        return;
+
+    m_shape.setPosition(getPosition());
     window.draw(m_shape);
 }
 
@@ -86,12 +114,17 @@ void SquareRenderer::setColor(const sf::Color& color)
 
 void SquareRenderer::setPosition(const sf::Vector2f& position)
 {
-    m_shape.setPosition(position);
+    Transform* transform = m_owner ? m_owner->getComponent<Transform>() : nullptr;
+    if (transform)
+        transform->setPosition(position);
+    else
+        m_shape.setPosition(position);
 }
 
 sf::Vector2f SquareRenderer::getPosition() const
 {
-    return m_shape.getPosition();
+    const Transform* transform = m_owner ? m_owner->getComponent<Transform>() : nullptr;
+    return transform ? transform->getPosition() : m_shape.getPosition();
 }
 
 // PLAYER MOVE
@@ -129,7 +162,7 @@ void PlayerController::processInput(const sf::Event& event)
 
 void PlayerController::update(const float& deltaTime)
 {
-    auto hero = dynamic_cast<Hero*>(m_owner);
+    auto hero = m_owner ? m_owner->as<Hero>() : nullptr;
     if (hero && hero->getCurrentState() == stateName::death)
     {
         m_velocity = sf::Vector2f(0.f, 0.f);
@@ -162,15 +195,16 @@ void PlayerController::update(const float& deltaTime)
     m_velocity.x = currentVelocity.x + (targetVelocity.x - currentVelocity.x) * std::min(1.0f, deltaTime * smoothFactor);
     m_velocity.y = currentVelocity.y + (targetVelocity.y - currentVelocity.y) * std::min(1.0f, deltaTime * smoothFactor);
 
-    auto square_renderer = static_cast<SquareRenderer*>(m_owner->getComponent("SquareRenderer"));
-    if (square_renderer)
+    auto transform = m_owner->getComponent<Transform>();
+    if (transform)
     {
-        sf::Vector2f currentPos = square_renderer->getPosition();
+        sf::Vector2f currentPos = transform->getPosition();
         sf::Vector2f newPos = currentPos + m_velocity * deltaTime;
 
         float player_radius = 25.f;
-		newPos = WorldLimits::limits(newPos, player_radius);
-        square_renderer->setPosition(newPos);
+		newPos = WorldLimits::move(currentPos, newPos, player_radius);
+        transform->setPosition(newPos);
+        transform->setVelocity(m_velocity);
     }
 }
 
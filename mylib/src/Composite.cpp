@@ -1,30 +1,69 @@
 #include "Composite.h"
 
+#include <algorithm>
+
+#include "EntityLink.h"
+
 CompositeGameObject::CompositeGameObject(const std::string& name)
 	: GameObject(name)
 {
+	m_handle = getHandleTable().insert(this);
+}
+
+CompositeGameObject::~CompositeGameObject()
+{
+	getHandleTable().erase(m_handle);
+}
+
+void CompositeGameObject::renewHandle()
+{
+	getHandleTable().erase(m_handle);
+	m_handle = getHandleTable().insert(this);
+
+	if (auto link = getComponent<EntityLink>())
+		link->refreshOwnerRef();
+}
+
+CompositeGameObject* CompositeGameObject::resolve(GameObjectHandle handle)
+{
+	return getHandleTable().resolve(handle);
+}
+
+SlotTable<CompositeGameObject>& CompositeGameObject::getHandleTable()
+{
+	static SlotTable<CompositeGameObject> table;
+	return table;
 }
 
 void CompositeGameObject::processInput(const sf::Event& event)
 {
-	for (auto& component : m_components)
-		component.second->processInput(event);
+	if (m_dispatchDirty)
+		rebuildDispatchLists();
+
+	for (Component* component : m_inputComponents)
+		component->processInput(event);
 
 	GameObject::processInput(event);
 }
 
 void CompositeGameObject::update(const float& deltaTime)
 {
-	for (auto& component : m_components)
-		component.second->update(deltaTime);
+	if (m_dispatchDirty)
+		rebuildDispatchLists();
+
+	for (Component* component : m_updateComponents)
+		component->update(deltaTime);
 
 	GameObject::update(deltaTime);
 }
 
 void CompositeGameObject::render(sf::RenderWindow& window)
 {
-	for (auto& component : m_components)
-		component.second->render(window);
+	if (m_dispatchDirty)
+		rebuildDispatchLists();
+
+	for (Component* component : m_renderComponents)
+		component->render(window);
 
 	GameObject::render(window);
 }
@@ -33,7 +72,21 @@ void CompositeGameObject::addComponent(std::shared_ptr<Component> component)
 {
 	component->setOwner(this);
 	component->initialize();
+
+	auto existing = m_components.find(component->getName());
+	if (existing != m_components.end())
+	{
+		releaseSlot(existing->second.get());
+		forgetComponent(existing->second.get());
+	}
+
+	if (component->getType() != ComponentType::None)
+		m_slots[static_cast<size_t>(component->getType())] = component.get();
+
 	m_components[component->getName()] = component;
+
+	m_insertionOrder.push_back(component.get());
+	m_dispatchDirty = true;
 }
 
 Component* CompositeGameObject::getComponent(const std::string& name)
@@ -58,7 +111,62 @@ void CompositeGameObject::removeComponent(const std::string& name)
 {
 	auto iterator = m_components.find(name);
 	if (iterator != m_components.end())
+	{
+		releaseSlot(iterator->second.get());
+		forgetComponent(iterator->second.get());
 		m_components.erase(iterator);
+	}
+}
+
+void CompositeGameObject::markDispatchDirty()
+{
+	m_dispatchDirty = true;
+}
+
+void CompositeGameObject::releaseSlot(const Component* component)
+{
+	if (component->getType() == ComponentType::None)
+		return;
+
+	Component*& slot = m_slots[static_cast<size_t>(component->getType())];
+	if (slot == component)
+		slot = nullptr;
+}
+
+void CompositeGameObject::forgetComponent(const Component* component)
+{
+	m_insertionOrder.erase(std::remove(m_insertionOrder.begin(), m_insertionOrder.end(), component), m_insertionOrder.end());
+	m_dispatchDirty = true;
+}
+
+void CompositeGameObject::rebuildDispatchLists()
+{
+	m_inputComponents.clear();
+	m_updateComponents.clear();
+	m_renderComponents.clear();
+
+	for (Component* component : m_insertionOrder)
+	{
+		unsigned phases = component->getPhases();
+
+		if (phases & ComponentPhase::Input)
+			m_inputComponents.push_back(component);
+		if (phases & ComponentPhase::Update)
+			m_updateComponents.push_back(component);
+		if (phases & ComponentPhase::Render)
+			m_renderComponents.push_back(component);
+	}
+
+	auto byPriority = [](const Component* first, const Component* second)
+		{
+			return first->getPriority() < second->getPriority();
+		};
+
+	std::stable_sort(m_inputComponents.begin(), m_inputComponents.end(), byPriority);
+	std::stable_sort(m_updateComponents.begin(), m_updateComponents.end(), byPriority);
+	std::stable_sort(m_renderComponents.begin(), m_renderComponents.end(), byPriority);
+
+	m_dispatchDirty = false;
 }
 
 
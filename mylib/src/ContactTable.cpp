@@ -0,0 +1,22 @@
+#include "ContactTable.h"
+
+#include <algorithm>
+
+void ContactTable::beginStep()
+{
+    m_current.clear();
+}
+
+void ContactTable::add(HitboxHandle first, HitboxHandle second)
+{
+    if (second < first)
+        std::swap(first, second);
+
+    m_current.push_back({ first, second });
+}
+
+void ContactTable::sortCurrent()
+{
+    std::sort(m_current.begin(), m_current.end());
+    m_current.erase(std::unique(m_current.begin(), m_current.end()), m_current.end());
+}
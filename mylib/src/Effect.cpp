@@ -9,16 +9,35 @@
 BloodEffect::BloodEffect(const std::string& name)
     : CompositeGameObject(name)
 {
-    setCategory("Effect");
+    setCategory(Category::Effect);
+    setKind(Kind);
 }
 
 void BloodEffect::initialize(const sf::Vector2f& position, const sf::Vector2f& direction)
 {
     m_direction = direction;
 
-    auto square_renderer = std::make_shared<SquareRenderer>(32.0f, sf::Color::Transparent);
-    addComponent(square_renderer);
-    square_renderer->setPosition(position);
+    if (!getComponent<AnimationComponent>())
+        createComponents();
+
+    getComponent<Transform>()->setPosition(position);
+
+    auto animation_component = getComponent<AnimationComponent>();
+    animation_component->stopAnimation();
+    animation_component->playAnimation("blood");
+
+    float angle = atan2f(direction.y, direction.x) * 180.0f / 3.14159f;
+    angle += 90.0f;
+
+    auto& sprite = animation_component->m_sprite;
+    sprite.setRotation(angle);
+
+    updateAnimation();
+}
+
+void BloodEffect::createComponents()
+{
+    addComponent(std::make_shared<SquareRenderer>(32.0f, sf::Color::Transparent));
 
     auto animation_component = std::make_shared<AnimationComponent>();
     addComponent(animation_component);
@@ -31,26 +50,16 @@ void BloodEffect::initialize(const sf::Vector2f& position, const sf::Vector2f& d
     bloodAnimation.setStartPosition(sf::Vector2i(0, 0));
 
     animation_component->addAnimation("blood", bloodAnimation);
-    animation_component->playAnimation("blood");
-
-    float angle = atan2f(direction.y, direction.x) * 180.0f / 3.14159f;
     animation_component->setScale(sf::Vector2f(4.0f, 4.0f));
-
-    angle += 90.0f;
-
-    auto& sprite = animation_component->m_sprite;
-    sprite.setRotation(angle);
-
-    updateAnimation();
 }
 
 void BloodEffect::update(const float& deltaTime)
 {
-    auto self_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-    if (self_renderer)
+    auto self_transform = getComponent<Transform>();
+    if (self_transform)
     {
-        sf::Vector2f parentPos = self_renderer->getPosition();
-        self_renderer->setPosition(parentPos);
+        sf::Vector2f parentPos = self_transform->getPosition();
+        self_transform->setPosition(parentPos);
 
         updateAnimation();
     }
@@ -60,29 +69,28 @@ void BloodEffect::update(const float& deltaTime)
 
 bool BloodEffect::isFinished() const
 {
-    auto animation_component = static_cast<const AnimationComponent*>(getComponent("AnimationComponent"));
+    auto animation_component = getComponent<AnimationComponent>();
     return animation_component && animation_component->isAnimationFinished();
 }
 
 std::shared_ptr<BloodEffect> BloodEffect::createBloodEffect(const sf::Vector2f& position, const sf::Vector2f& direction)
 {
-    auto bloodEffect = std::make_shared<BloodEffect>();
-    bloodEffect->initialize(position, direction);
-
     if (Game::getInstance())
-        Game::getInstance()->addEffect(bloodEffect);
+        return Game::getInstance()->createBloodEffect(position, direction);
 
+    auto bloodEffect = std::make_shared<BloodEffect>();
+    bloodEffect->initialize(position, direction);
     return bloodEffect;
 }
 
 void BloodEffect::updateAnimation()
 {
-    auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto transform = getComponent<Transform>();
+    auto animation_component = getComponent<AnimationComponent>();
 
-    if (square_renderer && animation_component)
+    if (transform && animation_component)
     {
-        sf::Vector2f position = square_renderer->getPosition();
+        sf::Vector2f position = transform->getPosition();
         animation_component->updatePosition(position);
     }
 }
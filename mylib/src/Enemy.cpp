@@ -16,7 +16,10 @@ MeleeEnemy::MeleeEnemy(const std::string& name)
     , m_currentAttackCD(0.0f)
     , m_isAttacking(false)
 {
-    addTag("MeleeEnemy");
+    addTag(Tag::MeleeEnemy);
+    setKind(Kind);
+    createStates<MeleeEnemyStates::PatrolState, MeleeEnemyStates::ChaseState,
+        MeleeEnemyStates::AttackState, MeleeEnemyStates::RetreatState>();
     m_damage = 15;
     m_attackRadius = 60.0f;
     m_speed = 100.0f;
@@ -28,19 +31,30 @@ MeleeEnemy::~MeleeEnemy()
 
 void MeleeEnemy::init(const sf::Vector2f& pos)
 {
-    IEnemy::init(pos, 40.0f, sf::Color::Transparent, m_speed);
+    if (getComponent<Hitbox>())
+    {
+        respawn(pos);
+        m_currentAttackCD = 0.0f;
+        m_isAttacking = false;
+    }
+    else
+    {
+        IEnemy::init(pos, 40.0f, sf::Color::Transparent, m_speed);
 
-    configureAnimation();
+        configureAnimation();
 
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+        auto enemyHitbox = std::make_shared<Hitbox>(sf::Vector2f(60.f, 60.f));
+        enemyHitbox->setDebugDraw(false);
+        enemyHitbox->setCollisionLayer(CollisionLayer::Enemy);
+        enemyHitbox->setCollisionMask(CollisionLayer::Hero);
+        addComponent(enemyHitbox);
+    }
+
+    auto animation_component = getComponent<AnimationComponent>();
     if (animation_component)
         animation_component->playAnimation("run_down");
 
-    auto enemyHitbox = std::make_shared<Hitbox>(sf::Vector2f(60.f, 60.f));
-    enemyHitbox->setDebugDraw(false);
-    addComponent(enemyHitbox);
-
-    changeState(new MeleeEnemyStates::PatrolState());
+    changeState(MeleeEnemyStates::PatrolState::Kind);
 }
 
 void MeleeEnemy::Attack(float deltaTime)
@@ -80,14 +94,14 @@ void MeleeEnemy::configureAnimation()
     hurtSprite();
     deathAnimation();
 
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto animation_component = getComponent<AnimationComponent>();
     if (animation_component)
         animation_component->setScale(sf::Vector2f(2.0f, 2.0f));
 }
 
 void MeleeEnemy::downAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto animation_component = getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -106,7 +120,7 @@ void MeleeEnemy::downAnimation()
 
 void MeleeEnemy::sideAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto animation_component = getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -125,7 +139,7 @@ void MeleeEnemy::sideAnimation()
 
 void MeleeEnemy::upAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto animation_component = getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -144,7 +158,7 @@ void MeleeEnemy::upAnimation()
 
 void MeleeEnemy::hurtSprite()
 {
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto animation_component = getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -158,7 +172,7 @@ void MeleeEnemy::hurtSprite()
 
 void MeleeEnemy::deathAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto animation_component = getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -177,7 +191,10 @@ RangedEnemy::RangedEnemy(const std::string& name)
     , m_fireCD(2.0f)
     , m_currentFireCD(0.0f)
 {
-    addTag("RangedEnemy");
+    addTag(Tag::RangedEnemy);
+    setKind(Kind);
+    createStates<RangedEnemyStates::PatrolState, RangedEnemyStates::PositioningState,
+        RangedEnemyStates::AttackState, RangedEnemyStates::RetreatState>();
     m_damage = 10;
     m_attackRadius = 300.0f;
     m_speed = 100.0f;
@@ -189,19 +206,29 @@ RangedEnemy::~RangedEnemy()
 
 void RangedEnemy::init(const sf::Vector2f& pos)
 {
-    IEnemy::init(pos, 35.0f, sf::Color::Transparent, m_speed);
+    if (getComponent<Hitbox>())
+    {
+        respawn(pos);
+        m_currentFireCD = 0.0f;
+    }
+    else
+    {
+        IEnemy::init(pos, 35.0f, sf::Color::Transparent, m_speed);
 
-    configureAnimation();
+        configureAnimation();
 
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+        auto rangedEnemyHitbox = std::make_shared<Hitbox>(sf::Vector2f(60.f, 60.f));
+        rangedEnemyHitbox->setDebugDraw(false);
+        rangedEnemyHitbox->setCollisionLayer(CollisionLayer::Enemy);
+        rangedEnemyHitbox->setCollisionMask(CollisionLayer::Hero);
+        addComponent(rangedEnemyHitbox);
+    }
+
+    auto animation_component = getComponent<AnimationComponent>();
     if (animation_component)
         animation_component->playAnimation("run_down");
 
-    auto rangedEnemyHitbox = std::make_shared<Hitbox>(sf::Vector2f(60.f, 60.f));
-    rangedEnemyHitbox->setDebugDraw(false);
-    addComponent(rangedEnemyHitbox);
-
-    changeState(new RangedEnemyStates::PatrolState());
+    changeState(RangedEnemyStates::PatrolState::Kind);
 }
 
 void RangedEnemy::Attack(float deltaTime)
@@ -212,10 +239,10 @@ void RangedEnemy::Attack(float deltaTime)
 
 		SoundManager::getInstance().playSound("arrow_shoot", 60.f);
 
-        auto enemy_render = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-        if (enemy_render)
+        auto enemy_transform = getComponent<Transform>();
+        if (enemy_transform)
         {
-            sf::Vector2f enemyPos = enemy_render->getPosition();
+            sf::Vector2f enemyPos = enemy_transform->getPosition();
 
             sf::Vector2f direction = m_playerPos - enemyPos;
             float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
@@ -224,7 +251,7 @@ void RangedEnemy::Attack(float deltaTime)
             {
                 direction /= length;
 
-                auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+                auto animation_component = getComponent<AnimationComponent>();
                 if (animation_component)
                 {
                     std::string animationName;
@@ -263,11 +290,11 @@ bool RangedEnemy::isAtOptimalDistance() const
     if (!canDetectPlayer())
         return false;
 
-    auto square_renderer = static_cast<const SquareRenderer*>(getComponent("SquareRenderer"));
-    if (!square_renderer)
+    auto transform = getComponent<Transform>();
+    if (!transform)
         return false;
 
-    sf::Vector2f pos = square_renderer->getPosition();
+    sf::Vector2f pos = transform->getPosition();
     float distanceSq = (pos.x - m_playerPos.x) * (pos.x - m_playerPos.x) +
         (pos.y - m_playerPos.y) * (pos.y - m_playerPos.y);
 
@@ -282,11 +309,11 @@ void RangedEnemy::maintainDistance(float deltaTime)
     if (!canDetectPlayer())
         return;
 
-    auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-    if (!square_renderer)
+    auto transform = getComponent<Transform>();
+    if (!transform)
         return;
 
-    sf::Vector2f currentPos = square_renderer->getPosition();
+    sf::Vector2f currentPos = transform->getPosition();
     sf::Vector2f direction = m_playerPos - currentPos;
     float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
 
@@ -296,9 +323,9 @@ void RangedEnemy::maintainDistance(float deltaTime)
     direction /= distance;
 
     if (distance < m_optimalDistance * 0.8f)
-        square_renderer->setPosition(currentPos - direction * m_speed * deltaTime);
+        transform->setPosition(currentPos - direction * m_speed * deltaTime);
     else if (distance > m_optimalDistance * 1.2f)
-        square_renderer->setPosition(currentPos + direction * m_speed * deltaTime);
+        transform->setPosition(currentPos + direction * m_speed * deltaTime);
 }
 
 void RangedEnemy::configureAnimation()
@@ -309,14 +336,14 @@ void RangedEnemy::configureAnimation()
     hurtSprite();
     deathAnimation();
 
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto animation_component = getComponent<AnimationComponent>();
     if (animation_component)
         animation_component->setScale(sf::Vector2f(2.0f, 2.0f));
 }
 
 void RangedEnemy::downAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto animation_component = getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -335,7 +362,7 @@ void RangedEnemy::downAnimation()
 
 void RangedEnemy::sideAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto animation_component = getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -354,7 +381,7 @@ void RangedEnemy::sideAnimation()
 
 void RangedEnemy::upAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto animation_component = getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -373,7 +400,7 @@ void RangedEnemy::upAnimation()
 
 void RangedEnemy::hurtSprite()
 {
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto animation_component = getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -387,7 +414,7 @@ void RangedEnemy::hurtSprite()
 
 void RangedEnemy::deathAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto animation_component = getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -12,7 +12,7 @@ namespace MeleeEnemyStates
     {
         std::cout << enemy->getName() << " start patrol" << std::endl;
 
-        auto animation_component = static_cast<AnimationComponent*>(enemy->getComponent("AnimationComponent"));
+        auto animation_component = enemy->getComponent<AnimationComponent>();
         if (animation_component)
             animation_component->playAnimation("run_down");
     }
@@ -23,7 +23,7 @@ namespace MeleeEnemyStates
 
         if (enemy->canDetectPlayer())
         {
-            enemy->changeState(new ChaseState());
+            enemy->changeState(ChaseState::Kind);
             return;
         }
     }
@@ -37,7 +37,7 @@ namespace MeleeEnemyStates
     {
         std::cout << enemy->getName() << " chasing the player" << std::endl;
 
-        auto animation_component = static_cast<AnimationComponent*>(enemy->getComponent("AnimationComponent"));
+        auto animation_component = enemy->getComponent<AnimationComponent>();
         if (animation_component)
             animation_component->playAnimation("run_down");
     }
@@ -46,19 +46,19 @@ namespace MeleeEnemyStates
     {
         if (!enemy->canDetectPlayer())
         {
-            enemy->changeState(new PatrolState());
+            enemy->changeState(PatrolState::Kind);
             return;
         }
 
         if (enemy->isWithinAttackRange())
         {
-            enemy->changeState(new AttackState());
+            enemy->changeState(AttackState::Kind);
             return;
         }
 
         if (enemy->shouldRetreat())
         {
-            enemy->changeState(new RetreatState());
+            enemy->changeState(RetreatState::Kind);
             return;
         }
 
@@ -75,7 +75,7 @@ namespace MeleeEnemyStates
         std::cout << enemy->getName() << " attacking the player" << std::endl;
         m_attackTimer = 0.0f;
 
-        auto animation_component = static_cast<AnimationComponent*>(enemy->getComponent("AnimationComponent"));
+        auto animation_component = enemy->getComponent<AnimationComponent>();
         if (animation_component)
             animation_component->playAnimation("attack_down");
     }
@@ -84,19 +84,19 @@ namespace MeleeEnemyStates
     {
         if (!enemy->canDetectPlayer())
         {
-            enemy->changeState(new PatrolState());
+            enemy->changeState(PatrolState::Kind);
             return;
         }
 
         if (!enemy->isWithinAttackRange())
         {
-            enemy->changeState(new ChaseState());
+            enemy->changeState(ChaseState::Kind);
             return;
         }
 
         if (enemy->shouldRetreat())
         {
-            enemy->changeState(new RetreatState());
+            enemy->changeState(RetreatState::Kind);
             return;
         }
 
@@ -117,7 +117,7 @@ namespace MeleeEnemyStates
     {
         std::cout << enemy->getName() << " retreat !" << std::endl;
 
-        auto animation_component = static_cast<AnimationComponent*>(enemy->getComponent("AnimationComponent"));
+        auto animation_component = enemy->getComponent<AnimationComponent>();
         if (animation_component)
             animation_component->playAnimation("run_down");
     }
@@ -128,13 +128,13 @@ namespace MeleeEnemyStates
 
         if (!enemy->canDetectPlayer())
         {
-            enemy->changeState(new PatrolState());
+            enemy->changeState(PatrolState::Kind);
             return;
         }
 
         if (!enemy->shouldRetreat())
         {
-            enemy->changeState(new ChaseState());
+            enemy->changeState(ChaseState::Kind);
             return;
         }
     }
@@ -151,7 +151,7 @@ namespace RangedEnemyStates
     {
         std::cout << enemy->getName() << " start patrol" << std::endl;
 
-        auto animation_component = static_cast<AnimationComponent*>(enemy->getComponent("AnimationComponent"));
+        auto animation_component = enemy->getComponent<AnimationComponent>();
         if (animation_component)
             animation_component->playAnimation("run_down");
     }
@@ -162,7 +162,7 @@ namespace RangedEnemyStates
 
         if (enemy->canDetectPlayer())
         {
-            enemy->changeState(new PositioningState());
+            enemy->changeState(PositioningState::Kind);
             return;
         }
     }
@@ -176,32 +176,32 @@ namespace RangedEnemyStates
     {
         std::cout << enemy->getName() << " positioning at optimal distance" << std::endl;
 
-        auto animation_component = static_cast<AnimationComponent*>(enemy->getComponent("AnimationComponent"));
+        auto animation_component = enemy->getComponent<AnimationComponent>();
         if (animation_component)
             animation_component->playAnimation("run_down");
     }
 
     void PositioningState::update(IEnemy* enemy, float deltaTime)
     {
-        auto rangedEnemy = dynamic_cast<RangedEnemy*>(enemy);
+        auto rangedEnemy = enemy->as<RangedEnemy>();
         if (!rangedEnemy)
             return;
 
         if (!enemy->canDetectPlayer())
         {
-            enemy->changeState(new PatrolState());
+            enemy->changeState(PatrolState::Kind);
             return;
         }
 
         if (enemy->shouldRetreat())
         {
-            enemy->changeState(new RetreatState());
+            enemy->changeState(RetreatState::Kind);
             return;
         }
 
         if (rangedEnemy->isAtOptimalDistance())
         {
-            enemy->changeState(new AttackState());
+            enemy->changeState(AttackState::Kind);
             return;
         }
 
@@ -218,32 +218,32 @@ namespace RangedEnemyStates
         std::cout << enemy->getName() << " shooting the player" << std::endl;
         m_attackTimer = 0.0f;
 
-        auto animation_component = static_cast<AnimationComponent*>(enemy->getComponent("AnimationComponent"));
+        auto animation_component = enemy->getComponent<AnimationComponent>();
         if (animation_component)
             animation_component->playAnimation("attack_down");
     }
 
     void AttackState::update(IEnemy* enemy, float deltaTime)
     {
-        auto rangedEnemy = dynamic_cast<RangedEnemy*>(enemy);
+        auto rangedEnemy = enemy->as<RangedEnemy>();
         if (!rangedEnemy)
             return;
 
         if (!enemy->canDetectPlayer())
         {
-            enemy->changeState(new PatrolState());
+            enemy->changeState(PatrolState::Kind);
             return;
         }
 
         if (!rangedEnemy->isAtOptimalDistance())
         {
-            enemy->changeState(new PositioningState());
+            enemy->changeState(PositioningState::Kind);
             return;
         }
 
         if (enemy->shouldRetreat())
         {
-            enemy->changeState(new RetreatState());
+            enemy->changeState(RetreatState::Kind);
             return;
         }
 
@@ -264,7 +264,7 @@ namespace RangedEnemyStates
     {
         std::cout << enemy->getName() << " retreat !" << std::endl;
 
-        auto animation_component = static_cast<AnimationComponent*>(enemy->getComponent("AnimationComponent"));
+        auto animation_component = enemy->getComponent<AnimationComponent>();
         if (animation_component)
             animation_component->playAnimation("run_down");
     }
@@ -275,13 +275,13 @@ namespace RangedEnemyStates
 
         if (!enemy->canDetectPlayer())
         {
-            enemy->changeState(new PatrolState());
+            enemy->changeState(PatrolState::Kind);
             return;
         }
 
         if (!enemy->shouldRetreat())
         {
-            enemy->changeState(new PositioningState());
+            enemy->changeState(PositioningState::Kind);
             return;
         }
     }
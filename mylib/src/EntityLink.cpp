@@ -0,0 +1,36 @@
+#include "EntityLink.h"
+
+#include "Composite.h"
+
+EntityLink::EntityLink(EntityRegistry& registry)
+    : Component("EntityLink")
+    , m_registry(&registry)
+    , m_entity(registry.create())
+{
+}
+
+EntityLink::~EntityLink()
+{
+    m_registry->destroy(m_entity);
+}
+
+void EntityLink::initialize()
+{
+    Component::initialize();
+    refreshOwnerRef();
+}
+
+void EntityLink::refreshOwnerRef()
+{
+    m_registry->add<GameObjectRef>(m_entity, m_owner->getHandle());
+}
+
+Entity EntityLink::getEntity() const
+{
+    return m_entity;
+}
+
+EntityRegistry& EntityLink::getRegistry() const
+{
+    return *m_registry;
+}
@@ -0,0 +1,49 @@
+#include "EntityRegistry.h"
+
+EntityRegistry::EntityRegistry()
+    : m_aliveCount(0)
+{
+}
+
+Entity EntityRegistry::create()
+{
+    std::uint32_t index;
+    if (!m_freeIndices.empty())
+    {
+        index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+    }
+    else
+    {
+        index = static_cast<std::uint32_t>(m_generations.size());
+        m_generations.push_back(1);
+        m_alive.push_back(0);
+    }
+
+    m_alive[index] = 1;
+    ++m_aliveCount;
+
+    return { index, m_generations[index] };
+}
+
+void EntityRegistry::destroy(Entity entity)
+{
+    if (!isAlive(entity))
+        return;
+
+    for (auto& pool : m_pools)
+    {
+        if (pool)
+            pool->remove(entity.index);
+    }
+
+    m_alive[entity.index] = 0;
+    ++m_generations[entity.index];
+    m_freeIndices.push_back(entity.index);
+    --m_aliveCount;
+}
+
+bool EntityRegistry::isAlive(Entity entity) const
+{
+    return entity.index < m_generations.size() && m_alive[entity.index] && m_generations[entity.index] == entity.generation;
+}
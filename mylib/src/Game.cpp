@@ -1,5 +1,6 @@
 #include "Game.h"
 
+#include <algorithm>
 #include <iostream>
 #include <random>
 
@@ -9,11 +10,38 @@
 #include "Effect.h"
 #include "Enemy.h"
 #include "Map.h"
+#include "MotionSystem.h"
+#include "SpriteBatch.h"
 #include "TextureManager.h"
 #include "UI.h"
 
 Game* Game::m_gameInstance = nullptr;
 
+namespace
+{
+	// At the camera zoom a 1024px page grid shows at most 3x2 pages; the extra two keep the pages
+	// just left behind resident when the camera scrolls back and forth over a boundary.
+	const unsigned mapPageSize = 1024;
+	const size_t mapPageBudget = 8;
+
+	template <typename T>
+	void removePendingDestroy(std::vector<T*>& objects)
+	{
+		objects.erase(std::remove_if(objects.begin(), objects.end(),
+			[](const T* object) { return object->isPendingDestroy(); }), objects.end());
+	}
+
+	// The typed copy must be the only owner left when the pool checks, or it will not take the
+	// object back.
+	template <typename T>
+	void releaseToPool(ObjectPool<T>& pool, std::shared_ptr<CompositeGameObject> object)
+	{
+		std::shared_ptr<T> typed = std::static_pointer_cast<T>(object);
+		object.reset();
+		pool.release(std::move(typed));
+	}
+}
+
 Game::Game(sf::RenderWindow* window, const float& framerate)
 	: SceneBase(window, framerate, "Game")
 	, m_deadPlayer(false)
@@ -46,6 +74,7 @@ void Game::initialize()
 	setupHealthUI();
 	setEnemy();
 	setupScoreUI();
+	setupCollisionStatsUI();
 }
 
 void Game::setPlayer()
@@ -55,7 +84,7 @@ void Game::setPlayer()
 	addCameraToPlayer();
 	addHitboxToPlayer();
 
-	m_gameObjects.push_back(m_player);
+	addGameObject(m_player);
 }
 
 void Game::setEnemy()
@@ -78,7 +107,7 @@ void Game::addCameraToPlayer()
 
 void Game::addHitboxToPlayer()
 {
-	auto playerHitbox = static_cast<Hitbox*>(m_player->getComponent("Hitbox"));
+	auto playerHitbox = m_player->getComponent<Hitbox>();
 	if (playerHitbox)
 	{
 		playerHitbox->setEnterCollision([this](Hitbox* player, Hitbox* other)
@@ -90,11 +119,11 @@ void Game::addHitboxToPlayer()
 
 void Game::handlePlayerCollision(Hitbox* player, Hitbox* other)
 {
-	auto enemy = dynamic_cast<IEnemy*>(other->getOwner());
+	auto enemy = other->getOwner() ? other->getOwner()->as<IEnemy>() : nullptr;
 	if (!enemy) 
 		return;
 
-	auto hero = static_cast<Hero*>(player->getOwner());
+	auto hero = player->getOwner()->as<Hero>();
 	if (!hero) 
 		return;
 
@@ -113,11 +142,14 @@ void Game::handlePlayerCollision(Hitbox* player, Hitbox* other)
 void Game::setMap()
 {
 	m_map = std::make_shared<TilesMap>("BaseMap", repr, 16);
+	m_map->enableStaticCache(mapPageSize, mapPageBudget);
 
 	std::cout << "Map initialized with size: " << m_map->getWidth() << "x" << m_map->getHeight() << std::endl;
 	std::cout << "Map has " << m_map->getLayerCount() << " layers" << std::endl;
 
-	m_gameObjects.push_back(m_map);
+	WorldLimits::addSolidMap(m_map.get());
+
+	addGameObject(m_map);
 }
 
 void Game::setLayer()
@@ -125,54 +157,62 @@ void Game::setLayer()
 	m_mapLayers = std::make_shared<TilesMap>("PathLayer", path, 32);
 
 	m_mapLayers->setScale(2.0f, 2.0f);
+	m_mapLayers->enableStaticCache(mapPageSize, mapPageBudget);
 
 	std::cout << "Pathlayer has been added with size: " << m_mapLayers->getWidth()
 		<< "x" << m_mapLayers->getHeight() << std::endl;
 
-	m_gameObjects.push_back(m_mapLayers);
+	WorldLimits::addSolidMap(m_mapLayers.get());
+
+	addGameObject(m_mapLayers);
 }
 
 void Game::handlePlayerAttackingEnemy(Hero* hero, IEnemy* enemy)
 {
-	auto player_render = static_cast<SquareRenderer*>(hero->getComponent("SquareRenderer"));
-	if (!player_render)
+	auto player_transform = hero->getComponent<Transform>();
+	if (!player_transform)
 		return;
 
 	bool wasAlreadyDead = enemy->isDead();
 
-	sf::Vector2f playerPos = player_render->getPosition();
+	sf::Vector2f playerPos = player_transform->getPosition();
 	enemy->takeDamage(100, playerPos);
 	enemy->knockBack(playerPos, 600.0f);
 
 	if (!wasAlreadyDead && enemy->isDead())
 	{
-		auto meleeEnemy = dynamic_cast<MeleeEnemy*>(enemy);
-		if (meleeEnemy)
+		--m_aliveEnemyCount;
+
+		if (enemy->getKind() == EntityKind::MeleeEnemy)
 			addScore(100);
+		else if (enemy->getKind() == EntityKind::RangedEnemy)
+			addScore(150);
 		else
-		{
-			auto rangedEnemy = dynamic_cast<RangedEnemy*>(enemy);
-			if (rangedEnemy)
-				addScore(150);
-			else
-				addScore(50);
-		}
+			addScore(50);
 	}
 }
 
 void Game::handleEnemyAttackingPlayer(Hero* hero, IEnemy* enemy)
 {
-	auto enemy_render = static_cast<SquareRenderer*>(enemy->getComponent("SquareRenderer"));
-	if (!enemy_render)
+	auto enemy_transform = enemy->getComponent<Transform>();
+	if (!enemy_transform)
 		return;
 
-	sf::Vector2f enemyPos = enemy_render->getPosition();
+	sf::Vector2f enemyPos = enemy_transform->getPosition();
 	hero->takeDamage(10, enemyPos);
 	hero->knockBack(enemyPos, 500.0f);
 }
 
 void Game::processInput(const sf::Event& event)
 {
+	if (event.type == sf::Event::KeyPressed && m_collisionStatsUI)
+	{
+		if (event.key.code == sf::Keyboard::F3)
+			m_collisionStatsUI->toggle();
+		else if (event.key.code == sf::Keyboard::F4)
+			m_collisionStatsUI->dumpCsv();
+	}
+
 	m_player->processInput(event);
 
 	SceneBase::processInput(event);
@@ -190,31 +230,33 @@ void Game::update(const float& deltaTime)
 		m_enemySpawnTimer = 0.0f;
 	}
 
-	for (auto& gameObject : m_gameObjects)
+	MotionSystem::update(EntityRegistry::getInstance(), deltaTime);
+
+	// Objects spawned during the loop are appended and updated in the same step.
+	for (size_t idx = 0; idx < m_gameObjects.size(); ++idx)
 	{
-		if (gameObject)
-			gameObject->update(deltaTime);
+		if (m_gameObjects[idx])
+			m_gameObjects[idx]->update(deltaTime);
 	}
 
 	bool isPlayerDead = m_player->getCurrentState() == stateName::death;
 
 	if (isPlayerDead && !m_deadPlayer)
-		IEnemy::heroIsDead(m_gameObjects);
+		IEnemy::heroIsDead(m_enemies);
 	else if (!isPlayerDead)
 	{
-		auto player_render = static_cast<SquareRenderer*>(m_player->getComponent("SquareRenderer"));
-		if (player_render)
+		auto player_transform = m_player->getComponent<Transform>();
+		if (player_transform)
 		{
-			sf::Vector2f playerPos = player_render->getPosition();
-			IEnemy::updateAllEnemyLOS(m_gameObjects, playerPos);
+			sf::Vector2f playerPos = player_transform->getPosition();
+			IEnemy::updateAllEnemyLOS(m_enemies, playerPos);
 		}
 	}
 
 	m_deadPlayer = isPlayerDead;
 
-	cleanupProjectiles();
-	cleanupEffects();
-	cleanupDeadEnemies();
+	queueFinishedObjects();
+	flushDestroyQueue();
 	Hitbox::resolveCollisions(m_gameObjects);
 
 	Camera::getInstance().update(deltaTime);
@@ -229,50 +271,23 @@ void Game::render()
 	if (m_mapLayers)
 		m_mapLayers->render(*m_renderWindow);
 
-	std::vector<std::shared_ptr<CompositeGameObject>> gameObjects;
-	for (auto& game_object : m_gameObjects) 
-	{
-		if (!dynamic_cast<TilesMap*>(game_object.get()) && game_object->getCategory() != "UI") 
-			gameObjects.push_back(game_object);
-	}
+	sortRenderList();
 
-	std::sort(gameObjects.begin(), gameObjects.end(),
-		[](const std::shared_ptr<CompositeGameObject>& first, const std::shared_ptr<CompositeGameObject>& second)
-		{
-			auto first_enemy = dynamic_cast<IEnemy*>(first.get());
-			auto second_enemy = dynamic_cast<IEnemy*>(second.get());
-
-			if (first_enemy && first_enemy->isDead() && (!second_enemy || !second_enemy->isDead()))
-				return true;
-
-			if (second_enemy && second_enemy->isDead() && (!first_enemy || !first_enemy->isDead()))
-				return false;
-
-			auto first_square_render = static_cast<SquareRenderer*>(first->getComponent("SquareRenderer"));
-			auto second_square_render = static_cast<SquareRenderer*>(second->getComponent("SquareRenderer"));
-
-			if (first_square_render && second_square_render) 
-			{
-				float first_positionY = first_square_render->getPosition().y;
-				float second_positionY = second_square_render->getPosition().y;
-				return first_positionY < second_positionY;
-			}
-
-			return false;
-		});
-
-	for (auto& game_object : gameObjects) 
+	// Sprites are queued in render list order and drawn together once the whole list is walked.
+	SpriteBatch& sprite_batch = SpriteBatch::getInstance();
+	for (size_t idx = 0; idx < m_renderList.size(); ++idx)
 	{
-		game_object->render(*m_renderWindow);
+		sprite_batch.setDepth(static_cast<float>(idx));
+		m_renderList[idx].object->render(*m_renderWindow);
 	}
+	sprite_batch.flush(*m_renderWindow);
 
 	sf::View defaultView = m_renderWindow->getDefaultView();
 	m_renderWindow->setView(defaultView);
 
-	for (auto& game_object : m_gameObjects) 
+	for (auto ui_object : m_uiObjects) 
 	{
-		if (game_object->getCategory() == "UI") 
-			game_object->render(*m_renderWindow);
+		ui_object->render(*m_renderWindow);
 	}
 
 	if (!m_player->isAlive()) 
@@ -284,6 +299,36 @@ void Game::render()
 	SceneBase::render();
 }
 
+void Game::sortRenderList()
+{
+	for (auto& entry : m_renderList)
+	{
+		entry.dead = entry.enemy && entry.enemy->isDead();
+
+		auto transform = entry.object->getComponent<Transform>();
+		entry.y = transform ? transform->getPosition().y : 0.0f;
+	}
+
+	auto drawsBefore = [](const RenderEntry& first, const RenderEntry& second)
+		{
+			if (first.dead != second.dead)
+				return first.dead;
+			return first.y < second.y;
+		};
+
+	for (size_t idx = 1; idx < m_renderList.size(); ++idx)
+	{
+		if (!drawsBefore(m_renderList[idx], m_renderList[idx - 1]))
+			continue;
+
+		RenderEntry entry = m_renderList[idx];
+		size_t jdx = idx;
+		for (; jdx > 0 && drawsBefore(entry, m_renderList[jdx - 1]); --jdx)
+			m_renderList[jdx] = m_renderList[jdx - 1];
+		m_renderList[jdx] = entry;
+	}
+}
+
 Game* Game::getInstance()
 {
 	return m_gameInstance;
@@ -291,10 +336,10 @@ Game* Game::getInstance()
 
 std::shared_ptr<Arrow> Game::createArrow(const sf::Vector2f& pos, const sf::Vector2f& direction, int damage)
 {
-	auto arrow = std::make_shared<Arrow>("Arrow", 1);
+	auto arrow = m_arrowPool.acquire("Arrow", 1);
 	arrow->initialize(pos, direction, 400.f);
 
-	m_gameObjects.push_back(arrow);
+	addGameObject(arrow);
 	return arrow;
 }
 
@@ -303,45 +348,18 @@ void Game::enemyGenerator(int initialCount)
 	spawnEnemyWave(initialCount);
 }
 
-void Game::cleanupProjectiles()
+std::shared_ptr<BloodEffect> Game::createBloodEffect(const sf::Vector2f& position, const sf::Vector2f& direction)
 {
-	auto iterator = m_gameObjects.begin();
-	while (iterator != m_gameObjects.end())
-	{
-		if ((*iterator)->getCategory() == "Projectile")
-		{
-			auto projectile = dynamic_cast<IProjectile*>(iterator->get());
-			if (projectile && projectile->isLifeTimePassed())
-			{
-				iterator = m_gameObjects.erase(iterator);
-				continue;
-			}
-		}
-		++iterator;
-	}
-}
+	auto bloodEffect = m_bloodEffectPool.acquire();
+	bloodEffect->initialize(position, direction);
 
-void Game::addEffect(std::shared_ptr<CompositeGameObject> effect)
-{
-	m_gameObjects.push_back(effect);
+	addGameObject(bloodEffect);
+	return bloodEffect;
 }
 
-void Game::cleanupEffects()
+void Game::addEffect(std::shared_ptr<CompositeGameObject> effect)
 {
-	auto iterator = m_gameObjects.begin();
-	while (iterator != m_gameObjects.end())
-	{
-		if ((*iterator)->getCategory() == "Effect")
-		{
-			auto effect = dynamic_cast<BloodEffect*>(iterator->get());
-			if (effect && effect->isFinished())
-			{
-				iterator = m_gameObjects.erase(iterator);
-				continue;
-			}
-		}
-		++iterator;
-	}
+	addGameObject(effect);
 }
 
 void Game::setupHealthUI()
@@ -351,7 +369,7 @@ void Game::setupHealthUI()
 
 	m_healthUI->setPosition(sf::Vector2f(100.f, 100.f));
 
-	m_gameObjects.push_back(m_healthUI);
+	addGameObject(m_healthUI);
 }
 
 void Game::displayGameOver()
@@ -380,13 +398,7 @@ void Game::displayGameOver()
 
 int Game::getCurrentEnemyCount() const
 {
-	int count = 0;
-	for (const auto& game_object : m_gameObjects)
-	{
-		if (game_object && game_object->getCategory() == "Enemy" && !dynamic_cast<IEnemy*>(game_object.get())->isDead())
-			count++;
-	}
-	return count;
+	return m_aliveEnemyCount;
 }
 
 void Game::spawnEnemyWave(int count)
@@ -398,7 +410,7 @@ void Game::spawnEnemyWave(int count)
 		sf::Vector2f spawnPos = getRandomSpawnPosition();
 		std::shared_ptr<IEnemy> enemy = createRandomEnemy(spawnPos, ++enemyIndex);
 
-		m_gameObjects.push_back(enemy);
+		addGameObject(enemy);
 	}
 }
 
@@ -408,9 +420,9 @@ sf::Vector2f Game::getRandomSpawnPosition()
 	static std::mt19937 gen(random_device());
 
 	sf::Vector2f playerPos;
-	auto player_renderer = static_cast<SquareRenderer*>(m_player->getComponent("SquareRenderer"));
-	if (player_renderer)
-		playerPos = player_renderer->getPosition();
+	auto player_transform = m_player->getComponent<Transform>();
+	if (player_transform)
+		playerPos = player_transform->getPosition();
 
 	std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * 3.14159f);
 	float angle = angleDist(gen);
@@ -440,15 +452,22 @@ std::shared_ptr<IEnemy> Game::createRandomEnemy(const sf::Vector2f& position, in
 	int enemyType = randomEnemy(gen);
 	std::shared_ptr<IEnemy> enemy;
 
+	// Only enemies the pools build are named; a reused one keeps the name of its first life.
 	if (enemyType == 0)
 	{
-		auto meleeEnemy = std::make_shared<MeleeEnemy>("MeleeEnemy" + std::to_string(index));
+		size_t created = m_meleeEnemyPool.getCreatedCount();
+		auto meleeEnemy = m_meleeEnemyPool.acquire("MeleeEnemy");
+		if (m_meleeEnemyPool.getCreatedCount() != created)
+			meleeEnemy->setName("MeleeEnemy" + std::to_string(index));
 		meleeEnemy->init(position);
 		enemy = meleeEnemy;
 	}
 	else
 	{
-		auto rangedEnemy = std::make_shared<RangedEnemy>("RangedEnemy" + std::to_string(index));
+		size_t created = m_rangedEnemyPool.getCreatedCount();
+		auto rangedEnemy = m_rangedEnemyPool.acquire("RangedEnemy");
+		if (m_rangedEnemyPool.getCreatedCount() != created)
+			rangedEnemy->setName("RangedEnemy" + std::to_string(index));
 		rangedEnemy->init(position);
 		enemy = rangedEnemy;
 	}
@@ -456,32 +475,146 @@ std::shared_ptr<IEnemy> Game::createRandomEnemy(const sf::Vector2f& position, in
 	return enemy;
 }
 
-void Game::cleanupDeadEnemies()
+void Game::addGameObject(const std::shared_ptr<CompositeGameObject>& object)
+{
+	m_gameObjects.push_back(object);
+
+	switch (object->getCategoryId())
+	{
+	case Category::Enemy:
+		if (auto enemy = object->as<IEnemy>())
+		{
+			m_enemies.push_back(enemy);
+			if (!enemy->isDead())
+				++m_aliveEnemyCount;
+		}
+		break;
+	case Category::Projectile:
+		if (auto projectile = object->as<IProjectile>())
+			m_projectiles.push_back(projectile);
+		break;
+	case Category::Effect:
+		if (auto effect = object->as<BloodEffect>())
+			m_effects.push_back(effect);
+		break;
+	case Category::UI:
+		m_uiObjects.push_back(object.get());
+		break;
+	default:
+		break;
+	}
+
+	if (!object->isCategory(Category::UI) && object->getKind() != EntityKind::TilesMap)
+		m_renderList.push_back({ object.get(), object->as<IEnemy>(), false, 0.0f });
+}
+
+void Game::destroy(CompositeGameObject* object)
 {
+	if (!object || object->isPendingDestroy())
+		return;
+
+	object->setPendingDestroy(true);
+	++m_pendingDestroyCount;
+}
+
+void Game::queueFinishedObjects()
+{
+	for (auto projectile : m_projectiles)
+	{
+		if (projectile->isLifeTimePassed())
+			destroy(projectile);
+	}
+
+	for (auto effect : m_effects)
+	{
+		if (effect->isFinished())
+			destroy(effect);
+	}
+
+	// Dead enemies stay on the ground until they are off screen.
 	sf::FloatRect visibleArea = Camera::getInstance().getVisibleArea();
 	visibleArea.left -= 200.0f;
 	visibleArea.top -= 200.0f;
 	visibleArea.width += 400.0f;
 	visibleArea.height += 400.0f;
 
-	auto iterator = m_gameObjects.begin();
-	while (iterator != m_gameObjects.end())
+	for (auto enemy : m_enemies)
 	{
-		auto enemy = dynamic_cast<IEnemy*>(iterator->get());
-		if (enemy && enemy->isDead())
+		if (!enemy->isDead())
+			continue;
+
+		auto transform = enemy->getComponent<Transform>();
+		if (transform && !visibleArea.contains(transform->getPosition()))
+			destroy(enemy);
+	}
+}
+
+void Game::flushDestroyQueue()
+{
+	if (m_pendingDestroyCount == 0)
+		return;
+
+	for (auto enemy : m_enemies)
+	{
+		if (enemy->isPendingDestroy() && !enemy->isDead())
+			--m_aliveEnemyCount;
+	}
+
+	removePendingDestroy(m_enemies);
+	removePendingDestroy(m_projectiles);
+	removePendingDestroy(m_effects);
+	removePendingDestroy(m_uiObjects);
+
+	m_renderList.erase(std::remove_if(m_renderList.begin(), m_renderList.end(),
+		[](const RenderEntry& entry) { return entry.object->isPendingDestroy(); }), m_renderList.end());
+
+	// One compaction pass keeps the survivors in order, however many objects died this step.
+	size_t kept = 0;
+	for (size_t idx = 0; idx < m_gameObjects.size(); ++idx)
+	{
+		if (m_gameObjects[idx]->isPendingDestroy())
 		{
-			auto renderer = static_cast<SquareRenderer*>((*iterator)->getComponent("SquareRenderer"));
-			if (renderer)
-			{
-				sf::Vector2f pos = renderer->getPosition();
-				if (!visibleArea.contains(pos))
-				{
-					iterator = m_gameObjects.erase(iterator);
-					continue;
-				}
-			}
+			m_destroyed.push_back(std::move(m_gameObjects[idx]));
+			continue;
 		}
-		++iterator;
+
+		if (kept != idx)
+			m_gameObjects[kept] = std::move(m_gameObjects[idx]);
+		++kept;
+	}
+	m_gameObjects.resize(kept);
+
+	for (auto& object : m_destroyed)
+	{
+		object->setPendingDestroy(false);
+		recycle(std::move(object));
+	}
+	m_destroyed.clear();
+	m_pendingDestroyCount = 0;
+}
+
+void Game::recycle(std::shared_ptr<CompositeGameObject> object)
+{
+	// Handles taken during this life must not resolve to the object's next one.
+	object->renewHandle();
+
+	switch (object->getKind())
+	{
+	case EntityKind::Arrow:
+		object->as<Arrow>()->deactivate();
+		releaseToPool(m_arrowPool, std::move(object));
+		break;
+	case EntityKind::BloodEffect:
+		releaseToPool(m_bloodEffectPool, std::move(object));
+		break;
+	case EntityKind::MeleeEnemy:
+		releaseToPool(m_meleeEnemyPool, std::move(object));
+		break;
+	case EntityKind::RangedEnemy:
+		releaseToPool(m_rangedEnemyPool, std::move(object));
+		break;
+	default:
+		break;
 	}
 }
 
@@ -495,5 +628,12 @@ void Game::setupScoreUI()
 	m_scoreUI = std::make_shared<ScoreUI>("PlayerScoreUI");
 	m_scoreUI->initialize(this, 0.25f);
 	m_scoreUI->setPosition(sf::Vector2f(910.f, 50.f));
-	m_gameObjects.push_back(m_scoreUI);
+	addGameObject(m_scoreUI);
+}
+
+void Game::setupCollisionStatsUI()
+{
+	m_collisionStatsUI = std::make_shared<CollisionStatsUI>("CollisionStatsUI");
+	m_collisionStatsUI->initialize();
+	addGameObject(m_collisionStatsUI);
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 GameObject::GameObject(const std::string& name)
 	: m_name(name)
+	, m_category(Category::None)
+	, m_tags(0)
 {
 }
 
@@ -62,31 +64,41 @@ std::string GameObject::getName() const
 }
 
 void GameObject::setCategory(const std::string& category)
+{
+	m_category = TagRegistry::getInstance().internCategory(category);
+}
+
+void GameObject::setCategory(TagId category)
 {
 	m_category = category;
 }
 
-std::string GameObject::getCategory() const
+const std::string& GameObject::getCategory() const
 {
-	return m_category;
+	return TagRegistry::getInstance().getCategoryName(m_category);
 }
 
 void GameObject::addTag(const std::string& tag)
 {
-	m_tags.insert(tag);
+	addTag(TagRegistry::getInstance().internTag(tag));
+}
+
+void GameObject::addTag(TagId tag)
+{
+	m_tags |= TagRegistry::bit(tag);
 }
 
 void GameObject::removeTag(const std::string& tag)
 {
-	m_tags.erase(tag);
+	removeTag(TagRegistry::getInstance().findTag(tag));
 }
 
-bool GameObject::hasTag(const std::string& tag) const
+void GameObject::removeTag(TagId tag)
 {
-	return m_tags.find(tag) != m_tags.end();
+	m_tags &= ~TagRegistry::bit(tag);
 }
 
-const std::unordered_set<std::string>& GameObject::getTags() const
+bool GameObject::hasTag(const std::string& tag) const
 {
-	return m_tags;
-}
\ No newline at end of file
+	return hasTag(TagRegistry::getInstance().findTag(tag));
+}
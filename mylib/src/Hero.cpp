@@ -19,8 +19,9 @@ Hero::Hero(const std::string& name)
     , m_speed(200.0f)
     , m_stateManager(this)
 {
-    setCategory("Player");
-    addTag("Hero");
+    setCategory(Category::Player);
+    setKind(Kind);
+    addTag(Tag::Hero);
 }
 
 void Hero::initialize(const sf::Vector2f& position, const float& size, const sf::Color& color, const float& speed)
@@ -37,6 +38,8 @@ void Hero::initialize(const sf::Vector2f& position, const float& size, const sf:
 
     auto hitbox = std::make_shared<Hitbox>(sf::Vector2f(60.f, 60.f));
     hitbox->setDebugDraw(false);
+    hitbox->setCollisionLayer(CollisionLayer::Hero);
+    hitbox->setCollisionMask(CollisionLayer::Enemy | CollisionLayer::Projectile);
     addComponent(hitbox);
 
     auto sound_component = std::make_shared<SoundComponent>();
@@ -53,10 +56,10 @@ void Hero::update(const float& deltaTime)
     {
         m_knockBackDuration -= deltaTime;
 
-        auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-        if (square_renderer)
+        auto transform = getComponent<Transform>();
+        if (transform)
         {
-            sf::Vector2f currentPos = square_renderer->getPosition();
+            sf::Vector2f currentPos = transform->getPosition();
 
             float slowdown_factor = std::min(1.0f, 4.0f * deltaTime);
             m_knockBack *= (1.0f - slowdown_factor);
@@ -65,7 +68,7 @@ void Hero::update(const float& deltaTime)
 
             float playerRadius = 25.f;
 			newPos = WorldLimits::limits(newPos, playerRadius);
-            square_renderer->setPosition(currentPos + m_knockBack * deltaTime);
+            transform->setPosition(currentPos + m_knockBack * deltaTime);
         }
     }
 
@@ -76,12 +79,12 @@ void Hero::update(const float& deltaTime)
 
 void Hero::updateAnimationPosition()
 {
-    auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto transform = getComponent<Transform>();
+    auto animation_component = getComponent<AnimationComponent>();
 
-    if (square_renderer && animation_component) 
+    if (transform && animation_component) 
     {
-        sf::Vector2f position = square_renderer->getPosition();
+        sf::Vector2f position = transform->getPosition();
         animation_component->updatePosition(position);
     }
 }
@@ -107,10 +110,10 @@ void Hero::takeDamage(int amount, const sf::Vector2f& attackerPos)
 
 	SoundManager::getInstance().playSound("hit", 80.f);
 
-	auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-	if (square_renderer)
+	auto transform = getComponent<Transform>();
+	if (transform)
     {
-        sf::Vector2f position = square_renderer->getPosition();
+        sf::Vector2f position = transform->getPosition();
         sf::Vector2f entryDirection = position - attackerPos;
         sf::Vector2f bloodDirection = entryDirection;
         
@@ -137,11 +140,11 @@ void Hero::takeDamage(int amount, const sf::Vector2f& attackerPos)
 
 void Hero::move(const sf::Vector2f& offset)
 {
-    auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-    if (square_renderer) 
+    auto transform = getComponent<Transform>();
+    if (transform) 
     {
-        sf::Vector2f currentPos = square_renderer->getPosition();
-        square_renderer->setPosition(currentPos + offset);
+        sf::Vector2f currentPos = transform->getPosition();
+        transform->setPosition(currentPos + offset);
     }
 }
 
@@ -189,7 +192,7 @@ void Hero::setState(stateName newState)
 {
     m_currentStateName = newState;
 
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto animation_component = getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -268,11 +271,11 @@ void Hero::knockBack(const sf::Vector2f& pos, float force)
         return;
     }
 
-    auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-    if (!square_renderer)
+    auto transform = getComponent<Transform>();
+    if (!transform)
         return;
 
-    sf::Vector2f heroPos = square_renderer->getPosition();
+    sf::Vector2f heroPos = transform->getPosition();
 
     sf::Vector2f direction = heroPos - pos;
 
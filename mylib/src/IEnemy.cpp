@@ -8,6 +8,7 @@
 #include "Collision.h"
 #include "Effect.h"
 #include "Enemy.h"
+#include "Map.h"
 
 IEnemy::IEnemy(const std::string& name)
     : CompositeGameObject(name)
@@ -30,14 +31,13 @@ IEnemy::IEnemy(const std::string& name)
 	, m_patrolmaxDistance(300.f)
 	, m_spawnPos(0.f, 0.f)
 {
-    setCategory("Enemy");
+    setCategory(Category::Enemy);
 
     m_currentPatrolDirection = randomDirectionGenerator();
 }
 
 IEnemy::~IEnemy()
 {
-    delete m_currentState;
 }
 
 void IEnemy::init(const sf::Vector2f& position, const float& size,
@@ -51,10 +51,38 @@ void IEnemy::init(const sf::Vector2f& position, const float& size,
     addComponent(animation_component);
 
     m_speed = speed;
+    m_bodyRadius = size / 2.0f;
 
     m_spawnPos = position;
 }
 
+void IEnemy::respawn(const sf::Vector2f& position)
+{
+    m_health = m_maxHealth;
+    m_isDead = false;
+    m_isPlayerDetected = false;
+    m_knockBack = sf::Vector2f(0.f, 0.f);
+    m_knockbackDuration = 0.0f;
+    m_timerForPatrol = 0.f;
+    m_currentPatrolDirection = randomDirectionGenerator();
+    m_spawnPos = position;
+
+    auto transform = getComponent<Transform>();
+    if (transform)
+    {
+        transform->setPosition(position);
+        transform->setVelocity(sf::Vector2f(0.f, 0.f));
+    }
+
+    auto hitbox = getComponent<Hitbox>();
+    if (hitbox)
+        hitbox->recycle();
+
+    auto animation_component = getComponent<AnimationComponent>();
+    if (animation_component)
+        animation_component->stopAnimation();
+}
+
 void IEnemy::update(const float& deltaTime)
 {
     if (m_isDead)
@@ -68,15 +96,15 @@ void IEnemy::update(const float& deltaTime)
     {
         m_knockbackDuration -= deltaTime;
 
-        auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-        if (square_renderer)
+        auto transform = getComponent<Transform>();
+        if (transform)
         {
-            sf::Vector2f currentPos = square_renderer->getPosition();
+            sf::Vector2f currentPos = transform->getPosition();
 
             float slowdown_factor = std::min(1.0f, 3.0f * deltaTime);
             m_knockBack *= (1.0f - slowdown_factor);
 
-            square_renderer->setPosition(currentPos + m_knockBack * deltaTime);
+            transform->setPosition(currentPos + m_knockBack * deltaTime);
         }
     }
     else if (m_currentState)
@@ -88,27 +116,29 @@ void IEnemy::update(const float& deltaTime)
     CompositeGameObject::update(deltaTime);
 }
 
-void IEnemy::changeState(IEnemyState* newState)
+void IEnemy::changeState(EnemyStateKind kind)
 {
     if (m_currentState)
-    {
         m_currentState->exitState(this);
-        delete m_currentState;
-    }
 
-    m_currentState = newState;
+    m_currentState = m_states[static_cast<size_t>(kind)].get();
     if (m_currentState)
         m_currentState->enterState(this);
 }
 
+void IEnemy::setState(std::unique_ptr<IEnemyState> state)
+{
+    m_states[static_cast<size_t>(state->getKind())] = std::move(state);
+}
+
 void IEnemy::updateAnimation()
 {
-    auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto transform = getComponent<Transform>();
+    auto animation_component = getComponent<AnimationComponent>();
 
-    if (square_renderer && animation_component)
+    if (transform && animation_component)
     {
-        sf::Vector2f position = square_renderer->getPosition();
+        sf::Vector2f position = transform->getPosition();
         animation_component->updatePosition(position);
     }
 }
@@ -118,12 +148,12 @@ void IEnemy::updateVisualDirection()
     if (!m_isPlayerDetected)
         return;
 
-    auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
-    if (!square_renderer || !animation_component)
+    auto transform = getComponent<Transform>();
+    auto animation_component = getComponent<AnimationComponent>();
+    if (!transform || !animation_component)
         return;
 
-    sf::Vector2f enemyPos = square_renderer->getPosition();
+    sf::Vector2f enemyPos = transform->getPosition();
 
     float dx = m_playerPos.x - enemyPos.x;
     float dy = m_playerPos.y - enemyPos.y;
@@ -179,11 +209,11 @@ void IEnemy::updateVisualDirection()
 
 void IEnemy::knockBack(const sf::Vector2f& pos, float force)
 {
-    auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-    if (!square_renderer)
+    auto transform = getComponent<Transform>();
+    if (!transform)
         return;
 
-    sf::Vector2f enemyPos = square_renderer->getPosition();
+    sf::Vector2f enemyPos = transform->getPosition();
 
     sf::Vector2f direction = enemyPos - pos;
 
@@ -207,12 +237,11 @@ bool IEnemy::isDead() const
 
 bool IEnemy::isNotAttacking() const
 {
-    auto melee_retreat = dynamic_cast<const MeleeEnemyStates::RetreatState*>(m_currentState);
-    auto ranged_retreat = dynamic_cast<const RangedEnemyStates::RetreatState*>(m_currentState);
-
-    auto positioningState = dynamic_cast<const RangedEnemyStates::PositioningState*>(m_currentState);
+    if (!m_currentState)
+        return false;
 
-    return (melee_retreat != nullptr || ranged_retreat != nullptr || positioningState != nullptr);
+    EnemyStateKind kind = m_currentState->getKind();
+    return kind == EnemyStateKind::Retreat || kind == EnemyStateKind::Positioning;
 }
 
 void IEnemy::setSpawnPosition(const sf::Vector2f& pos)
@@ -220,26 +249,16 @@ void IEnemy::setSpawnPosition(const sf::Vector2f& pos)
     m_spawnPos = pos;
 }
 
-void IEnemy::heroIsDead(std::vector<std::shared_ptr<CompositeGameObject>>& gameObjects)
+void IEnemy::heroIsDead(const std::vector<IEnemy*>& enemies)
 {
-    for (auto& object : gameObjects)
+    for (auto enemy : enemies)
     {
-        if (object->getCategory() == "Enemy")
-        {
-            auto enemy = dynamic_cast<IEnemy*>(object.get());
-            if (enemy && !enemy->isDead())
-            {
-                enemy->forgetPlayer();
-
-                auto melee_enemy = dynamic_cast<MeleeEnemy*>(enemy);
-                if (melee_enemy)
-                    melee_enemy->changeState(new MeleeEnemyStates::PatrolState());
-
-                auto ranged_enemy = dynamic_cast<RangedEnemy*>(enemy);
-                if (ranged_enemy)
-                    ranged_enemy->changeState(new RangedEnemyStates::PatrolState());
-            }
-        }
+        if (enemy->isDead())
+            continue;
+
+        enemy->forgetPlayer();
+
+        enemy->changeState(EnemyStateKind::Patrol);
     }
 }
 
@@ -272,11 +291,11 @@ bool IEnemy::canDetectPlayer() const
 
 bool IEnemy::isWithinAttackRange() const
 {
-    auto square_renderer = static_cast<const SquareRenderer*>(getComponent("SquareRenderer"));
-    if (!square_renderer || !m_isPlayerDetected)
+    auto transform = getComponent<Transform>();
+    if (!transform || !m_isPlayerDetected)
         return false;
 
-    sf::Vector2f pos = square_renderer->getPosition();
+    sf::Vector2f pos = transform->getPosition();
     float distance = (pos.x - m_playerPos.x) * (pos.x - m_playerPos.x) +
         (pos.y - m_playerPos.y) * (pos.y - m_playerPos.y);
 
@@ -290,11 +309,11 @@ bool IEnemy::shouldRetreat() const
 
 void IEnemy::patrol(float deltaTime)
 {
-    auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-    if (!square_renderer)
+    auto transform = getComponent<Transform>();
+    if (!transform)
         return;
 
-    sf::Vector2f currentPos = square_renderer->getPosition();
+    sf::Vector2f currentPos = transform->getPosition();
 
     m_timerForPatrol += deltaTime;
 
@@ -318,7 +337,7 @@ void IEnemy::patrol(float deltaTime)
             m_currentPatrolDirection /= length;
     }
 
-    square_renderer->setPosition(currentPos + m_currentPatrolDirection * m_speed * deltaTime);
+    transform->setPosition(WorldLimits::move(currentPos, currentPos + m_currentPatrolDirection * m_speed * deltaTime, m_bodyRadius));
 }
 
 void IEnemy::moveTowardPlayer(float deltaTime)
@@ -326,11 +345,11 @@ void IEnemy::moveTowardPlayer(float deltaTime)
     if (!m_isPlayerDetected)
         return;
 
-    auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-    if (!square_renderer)
+    auto transform = getComponent<Transform>();
+    if (!transform)
         return;
 
-    sf::Vector2f currentPos = square_renderer->getPosition();
+    sf::Vector2f currentPos = transform->getPosition();
     sf::Vector2f direction = m_playerPos - currentPos;
     float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
 
@@ -341,7 +360,7 @@ void IEnemy::moveTowardPlayer(float deltaTime)
     {
         direction /= distance;
         direction *= m_speed * deltaTime;
-        square_renderer->setPosition(currentPos + direction);
+        transform->setPosition(WorldLimits::move(currentPos, currentPos + direction, m_bodyRadius));
     }
 }
 
@@ -350,11 +369,11 @@ void IEnemy::retreatFromPlayer(float deltaTime)
     if (!m_isPlayerDetected)
         return;
 
-    auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-    if (!square_renderer)
+    auto transform = getComponent<Transform>();
+    if (!transform)
         return;
 
-    sf::Vector2f currentPos = square_renderer->getPosition();
+    sf::Vector2f currentPos = transform->getPosition();
     sf::Vector2f direction = currentPos - m_playerPos;
     float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
 
@@ -362,17 +381,17 @@ void IEnemy::retreatFromPlayer(float deltaTime)
     {
         direction /= distance;
         direction *= m_speed * 1.2f * deltaTime;
-        square_renderer->setPosition(currentPos + direction);
+        transform->setPosition(currentPos + direction);
     }
 }
 
 void IEnemy::searchingArea(float deltaTime)
 {
-    auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-    if (!square_renderer)
+    auto transform = getComponent<Transform>();
+    if (!transform)
         return;
 
-    sf::Vector2f currentPos = square_renderer->getPosition();
+    sf::Vector2f currentPos = transform->getPosition();
     sf::Vector2f direction = m_lastKnownPlayerPos - currentPos;
     float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
 
@@ -386,7 +405,7 @@ void IEnemy::searchingArea(float deltaTime)
     {
         direction /= distance;
         direction *= m_speed * deltaTime;
-        square_renderer->setPosition(currentPos + direction);
+        transform->setPosition(currentPos + direction);
     }
 }
 
@@ -398,7 +417,7 @@ void IEnemy::takeDamage(int amount, const sf::Vector2f& attackerPos)
     m_health = std::max(0, m_health - amount);
     std::cout << getName() << " took " << amount << " damage! Health: " << m_health << "/" << m_maxHealth << std::endl;
 
-    auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+    auto animation_component = getComponent<AnimationComponent>();
 
     SoundManager::getInstance().playSound("hit", 80.f);
 
@@ -413,9 +432,12 @@ void IEnemy::takeDamage(int amount, const sf::Vector2f& attackerPos)
 		
         std::cout << getName() << " has been defeated!" << std::endl;
 
-        auto hitbox = static_cast<Hitbox*>(getComponent("Hitbox"));
+        auto hitbox = getComponent<Hitbox>();
         if (hitbox)
+        {
             hitbox->setDebugDraw(false);
+            hitbox->sleep();
+        }
     }
     else
     {
@@ -423,10 +445,10 @@ void IEnemy::takeDamage(int amount, const sf::Vector2f& attackerPos)
             animation_component->playAnimation("hurt");
     }
 
-    auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-    if (square_renderer)
+    auto transform = getComponent<Transform>();
+    if (transform)
     {
-        sf::Vector2f position = square_renderer->getPosition();
+        sf::Vector2f position = transform->getPosition();
 
         sf::Vector2f bloodDirection = position - attackerPos;
     	float length = std::sqrt(bloodDirection.x * bloodDirection.x + bloodDirection.y * bloodDirection.y);
@@ -450,11 +472,11 @@ void IEnemy::forgetPlayer()
 
 void IEnemy::updateLOS(const sf::Vector2f& playerPos)
 {
-    auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-    if (!square_renderer)
+    auto transform = getComponent<Transform>();
+    if (!transform)
         return;
 
-    sf::Vector2f currentPos = square_renderer->getPosition();
+    sf::Vector2f currentPos = transform->getPosition();
     float distSq = (currentPos.x - playerPos.x) * (currentPos.x - playerPos.x) +
         (currentPos.y - playerPos.y) * (currentPos.y - playerPos.y);
 
@@ -473,16 +495,8 @@ void IEnemy::updateLOS(const sf::Vector2f& playerPos)
         std::cout << getName() << " lost sight of the player!" << std::endl;
 }
 
-void IEnemy::updateAllEnemyLOS(std::vector<std::shared_ptr<CompositeGameObject>>& gameObjects,
-    const sf::Vector2f& playerPos)
+void IEnemy::updateAllEnemyLOS(const std::vector<IEnemy*>& enemies, const sf::Vector2f& playerPos)
 {
-    for (auto& object : gameObjects)
-    {
-        if (object->getCategory() == "Enemy")
-        {
-            auto enemy = dynamic_cast<IEnemy*>(object.get());
-            if (enemy)
-                enemy->updateLOS(playerPos);
-        }
-    }
+    for (auto enemy : enemies)
+        enemy->updateLOS(playerPos);
 }
\ No newline at end of file
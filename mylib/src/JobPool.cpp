@@ -0,0 +1,105 @@
+#include "JobPool.h"
+
+#include <algorithm>
+
+JobPool::JobPool()
+    : m_job(nullptr)
+    , m_count(0)
+    , m_chunk(1)
+    , m_next(0)
+    , m_busyWorkers(0)
+    , m_jobGeneration(0)
+    , m_stopping(false)
+{
+    unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (unsigned worker = 1; worker < hardwareThreads; ++worker)
+        m_threads.emplace_back(&JobPool::workerLoop, this, worker);
+}
+
+JobPool::~JobPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeWorkers.notify_all();
+
+    for (auto& thread : m_threads)
+        thread.join();
+}
+
+unsigned JobPool::getWorkerCount() const
+{
+    return static_cast<unsigned>(m_threads.size()) + 1;
+}
+
+void JobPool::parallelFor(size_t count, size_t minChunk, const Job& job)
+{
+    if (count == 0)
+        return;
+
+    size_t chunk = std::max<size_t>(1, minChunk);
+    chunk = std::max(chunk, (count + getWorkerCount() * 4 - 1) / (getWorkerCount() * 4));
+
+    if (m_threads.empty() || count <= chunk)
+    {
+        job(0, count, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &job;
+        m_count = count;
+        m_chunk = chunk;
+        m_next.store(0);
+        m_busyWorkers = static_cast<unsigned>(m_threads.size());
+        ++m_jobGeneration;
+    }
+    m_wakeWorkers.notify_all();
+
+    runChunks(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_jobDone.wait(lock, [this] { return m_busyWorkers == 0; });
+    m_job = nullptr;
+}
+
+void JobPool::workerLoop(unsigned worker)
+{
+    unsigned long long seenGeneration = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeWorkers.wait(lock, [this, seenGeneration] { return m_stopping || m_jobGeneration != seenGeneration; });
+
+            if (m_stopping)
+                return;
+
+            seenGeneration = m_jobGeneration;
+        }
+
+        runChunks(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_busyWorkers;
+        }
+        m_jobDone.notify_one();
+    }
+}
+
+void JobPool::runChunks(unsigned worker)
+{
+    while (true)
+    {
+        size_t begin = m_next.fetch_add(m_chunk);
+        if (begin >= m_count)
+            return;
+
+        (*m_job)(begin, std::min(begin + m_chunk, m_count), worker);
+    }
+}
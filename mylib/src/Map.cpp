@@ -1,7 +1,73 @@
 #include "Map.h"
+
+#include <algorithm>
+
 #include "Tiles.h"
 
 sf::FloatRect WorldLimits::m_world_bounds = sf::FloatRect(0, 0, 3000, 2500);
+std::vector<const TilesMap*> WorldLimits::m_solid_maps;
+
+void WorldLimits::addSolidMap(const TilesMap* tilesMap)
+{
+    if (tilesMap && std::find(m_solid_maps.begin(), m_solid_maps.end(), tilesMap) == m_solid_maps.end())
+        m_solid_maps.push_back(tilesMap);
+}
+
+void WorldLimits::removeSolidMap(const TilesMap* tilesMap)
+{
+    m_solid_maps.erase(std::remove(m_solid_maps.begin(), m_solid_maps.end(), tilesMap), m_solid_maps.end());
+}
+
+bool WorldLimits::isBlocked(const sf::Vector2f& position, float entityRadius)
+{
+    sf::FloatRect area(position.x - entityRadius, position.y - entityRadius, entityRadius * 2.0f, entityRadius * 2.0f);
+
+    for (const TilesMap* tilesMap : m_solid_maps)
+    {
+        if (tilesMap->isAreaSolid(area))
+            return true;
+    }
+
+    return false;
+}
+
+sf::Vector2f WorldLimits::move(const sf::Vector2f& from, const sf::Vector2f& to, float entityRadius)
+{
+    if (m_solid_maps.empty() || isBlocked(from, entityRadius))
+        return limits(to, entityRadius);
+
+    sf::Vector2f result = from;
+
+    for (int axis = 0; axis < 2; ++axis)
+    {
+        sf::Vector2f delta = axis == 0 ? sf::Vector2f(to.x - from.x, 0.0f) : sf::Vector2f(0.0f, to.y - from.y);
+        if (delta.x == 0.0f && delta.y == 0.0f)
+            continue;
+
+        if (!isBlocked(result + delta, entityRadius))
+        {
+            result += delta;
+            continue;
+        }
+
+        // Bisect for the furthest free point along the axis, so the entity ends up flush with
+        // the tile instead of stopping a whole step short.
+        float freeFraction = 0.0f;
+        float blockedFraction = 1.0f;
+        for (int iteration = 0; iteration < 8; ++iteration)
+        {
+            float fraction = (freeFraction + blockedFraction) / 2.0f;
+            if (isBlocked(result + delta * fraction, entityRadius))
+                blockedFraction = fraction;
+            else
+                freeFraction = fraction;
+        }
+
+        result += delta * freeFraction;
+    }
+
+    return limits(result, entityRadius);
+}
 
 MapRepresentation repr = {
      "HHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHHH"
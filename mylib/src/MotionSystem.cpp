@@ -0,0 +1,11 @@
+#include "MotionSystem.h"
+
+#include "Component.h"
+
+void MotionSystem::update(EntityRegistry& registry, float deltaTime)
+{
+    registry.each<Motion>([deltaTime](Entity, Motion& motion)
+        {
+            motion.transform->move(motion.velocity * deltaTime);
+        });
+}
@@ -11,7 +11,7 @@ IProjectile::IProjectile(const std::string& name)
 	, m_TimeBeforeDestroy(0.f)
 	, m_maxTimeBeforeDestroy(3.0f)
 {
-	setCategory("Projectile");
+	setCategory(Category::Projectile);
 }
 
 IProjectile::~IProjectile()
@@ -41,12 +41,12 @@ bool IProjectile::isLifeTimePassed() const
 
 void IProjectile::updateAnimation()
 {
-	auto square_renderer = static_cast<SquareRenderer*>(getComponent("SquareRenderer"));
-	auto animation_component = static_cast<AnimationComponent*>(getComponent("AnimationComponent"));
+	auto transform = getComponent<Transform>();
+	auto animation_component = getComponent<AnimationComponent>();
 
-	if (square_renderer && animation_component)
+	if (transform && animation_component)
 	{
-		sf::Vector2f position = square_renderer->getPosition();
+		sf::Vector2f position = transform->getPosition();
 		animation_component->updatePosition(position);
 	}
 }
@@ -0,0 +1,170 @@
+#include "SpatialGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(const sf::FloatRect& worldBounds, float cellSize)
+    : m_worldBounds(worldBounds)
+    , m_cellSize(cellSize)
+    , m_columns(1)
+    , m_rows(1)
+    , m_bounds(nullptr)
+    , m_layers(nullptr)
+    , m_masks(nullptr)
+    , m_queryMark(0)
+{
+    rebuildLayout();
+}
+
+void SpatialGrid::setWorldBounds(const sf::FloatRect& worldBounds)
+{
+    if (worldBounds == m_worldBounds)
+        return;
+
+    m_worldBounds = worldBounds;
+    rebuildLayout();
+}
+
+void SpatialGrid::setCellSize(float cellSize)
+{
+    if (cellSize <= 0.0f || cellSize == m_cellSize)
+        return;
+
+    m_cellSize = cellSize;
+    rebuildLayout();
+}
+
+void SpatialGrid::rebuildLayout()
+{
+    m_columns = std::max(1, static_cast<int>(std::ceil(m_worldBounds.width / m_cellSize)));
+    m_rows = std::max(1, static_cast<int>(std::ceil(m_worldBounds.height / m_cellSize)));
+
+    m_cellStart.assign(static_cast<size_t>(m_columns) * m_rows + 1, 0);
+}
+
+int SpatialGrid::cellColumn(float x) const
+{
+    int column = static_cast<int>(std::floor((x - m_worldBounds.left) / m_cellSize));
+    return std::max(0, std::min(m_columns - 1, column));
+}
+
+int SpatialGrid::cellRow(float y) const
+{
+    int row = static_cast<int>(std::floor((y - m_worldBounds.top) / m_cellSize));
+    return std::max(0, std::min(m_rows - 1, row));
+}
+
+void SpatialGrid::build(const AabbArray& bounds, const std::vector<std::uint32_t>& layers, const std::vector<std::uint32_t>& masks)
+{
+    m_bounds = &bounds;
+    m_layers = &layers;
+    m_masks = &masks;
+
+    m_entries.clear();
+
+    for (size_t id = 0; id < bounds.size(); ++id)
+    {
+        if (!layers[id] || !masks[id])
+            continue;
+
+        int startColumn = cellColumn(bounds.minX[id]);
+        int endColumn = cellColumn(bounds.maxX[id]);
+        int startRow = cellRow(bounds.minY[id]);
+        int endRow = cellRow(bounds.maxY[id]);
+
+        for (int row = startRow; row <= endRow; ++row)
+        {
+            for (int column = startColumn; column <= endColumn; ++column)
+                m_entries.push_back({ row * m_columns + column, static_cast<int>(id) });
+        }
+    }
+
+    // Counting sort of the entries by cell, so each cell's ids end up contiguous.
+    std::fill(m_cellStart.begin(), m_cellStart.end(), 0);
+    for (const Entry& entry : m_entries)
+        ++m_cellStart[entry.cell + 1];
+
+    for (size_t cell = 1; cell < m_cellStart.size(); ++cell)
+        m_cellStart[cell] += m_cellStart[cell - 1];
+
+    m_cellIds.resize(m_entries.size());
+    for (const Entry& entry : m_entries)
+        m_cellIds[m_cellStart[entry.cell]++] = entry.id;
+
+    for (size_t cell = m_cellStart.size() - 1; cell > 0; --cell)
+        m_cellStart[cell] = m_cellStart[cell - 1];
+    m_cellStart[0] = 0;
+
+    m_queryMarks.assign(bounds.size(), 0);
+    m_queryMark = 0;
+}
+
+void SpatialGrid::findPairs(std::vector<std::pair<int, int>>& pairs)
+{
+    pairs.clear();
+    if (!m_bounds)
+        return;
+
+    const int cellCount = m_columns * m_rows;
+    for (int cell = 0; cell < cellCount; ++cell)
+    {
+        int begin = m_cellStart[cell];
+        int end = m_cellStart[cell + 1];
+
+        for (int first = begin; first < end; ++first)
+        {
+            for (int second = first + 1; second < end; ++second)
+            {
+                int idA = std::min(m_cellIds[first], m_cellIds[second]);
+                int idB = std::max(m_cellIds[first], m_cellIds[second]);
+
+                if (!((*m_layers)[idA] & (*m_masks)[idB]) || !((*m_layers)[idB] & (*m_masks)[idA]))
+                    continue;
+
+                // A pair sharing several cells is only reported by the cell holding the
+                // top-left corner of the two boxes' intersection.
+                const AabbArray& bounds = *m_bounds;
+                int ownerCell = cellRow(std::max(bounds.minY[idA], bounds.minY[idB])) * m_columns
+                    + cellColumn(std::max(bounds.minX[idA], bounds.minX[idB]));
+
+                if (ownerCell == cell)
+                    pairs.emplace_back(idA, idB);
+            }
+        }
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+}
+
+void SpatialGrid::query(float minX, float minY, float maxX, float maxY, std::uint32_t layer, std::uint32_t mask, std::vector<int>& ids)
+{
+    if (!m_bounds || m_entries.empty())
+        return;
+
+    ++m_queryMark;
+
+    int startColumn = cellColumn(minX);
+    int endColumn = cellColumn(maxX);
+    int startRow = cellRow(minY);
+    int endRow = cellRow(maxY);
+
+    for (int row = startRow; row <= endRow; ++row)
+    {
+        for (int column = startColumn; column <= endColumn; ++column)
+        {
+            int cell = row * m_columns + column;
+
+            for (int entry = m_cellStart[cell]; entry < m_cellStart[cell + 1]; ++entry)
+            {
+                int id = m_cellIds[entry];
+                if (m_queryMarks[id] == m_queryMark)
+                    continue;
+
+                m_queryMarks[id] = m_queryMark;
+
+                if ((layer & (*m_masks)[id]) && ((*m_layers)[id] & mask))
+                    ids.push_back(id);
+            }
+        }
+    }
+}
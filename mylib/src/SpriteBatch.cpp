@@ -0,0 +1,116 @@
+#include "SpriteBatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace
+{
+    sf::FloatRect unite(const sf::FloatRect& first, const sf::FloatRect& second)
+    {
+        float left = std::min(first.left, second.left);
+        float top = std::min(first.top, second.top);
+        float right = std::max(first.left + first.width, second.left + second.width);
+        float bottom = std::max(first.top + first.height, second.top + second.height);
+
+        return sf::FloatRect(left, top, right - left, bottom - top);
+    }
+}
+
+SpriteBatch::SpriteBatch()
+    : m_depth(0.0f)
+    , m_drawCallCount(0)
+    , m_quadCount(0)
+{
+}
+
+void SpriteBatch::submit(const sf::Texture* texture, const sf::IntRect& rect, const sf::Transform& transform, const sf::Color& color)
+{
+    float width = static_cast<float>(std::abs(rect.width));
+    float height = static_cast<float>(std::abs(rect.height));
+
+    float left = static_cast<float>(rect.left);
+    float right = left + rect.width;
+    float top = static_cast<float>(rect.top);
+    float bottom = top + rect.height;
+
+    Quad quad;
+    quad.texture = texture;
+    quad.depth = m_depth;
+    quad.order = m_quads.size();
+    quad.vertices[0] = sf::Vertex(transform.transformPoint(0.0f, 0.0f), color, sf::Vector2f(left, top));
+    quad.vertices[1] = sf::Vertex(transform.transformPoint(width, 0.0f), color, sf::Vector2f(right, top));
+    quad.vertices[2] = sf::Vertex(transform.transformPoint(width, height), color, sf::Vector2f(right, bottom));
+    quad.vertices[3] = sf::Vertex(transform.transformPoint(0.0f, height), color, sf::Vector2f(left, bottom));
+    quad.bounds = transform.transformRect(sf::FloatRect(0.0f, 0.0f, width, height));
+
+    m_quads.push_back(quad);
+}
+
+void SpriteBatch::submit(const sf::Sprite& sprite)
+{
+    submit(sprite.getTexture(), sprite.getTextureRect(), sprite.getTransform(), sprite.getColor());
+}
+
+void SpriteBatch::flush(sf::RenderTarget& target)
+{
+    std::sort(m_quads.begin(), m_quads.end(),
+        [](const Quad& first, const Quad& second)
+        {
+            if (first.depth != second.depth)
+                return first.depth < second.depth;
+            if (first.texture != second.texture)
+                return std::less<const sf::Texture*>()(first.texture, second.texture);
+            return first.order < second.order;
+        });
+
+    // Batches are kept between frames so their vertex arrays reuse their storage.
+    size_t batchCount = 0;
+    for (const auto& quad : m_quads)
+    {
+        // Walk back from the newest batch: the quad may join a batch of its texture as long as no
+        // batch drawn after that one overlaps it.
+        size_t target_batch = batchCount;
+        for (size_t idx = batchCount; idx-- > 0;)
+        {
+            if (m_batches[idx].texture == quad.texture)
+            {
+                target_batch = idx;
+                break;
+            }
+
+            if (m_batches[idx].bounds.intersects(quad.bounds))
+                break;
+        }
+
+        if (target_batch == batchCount)
+        {
+            if (m_batches.size() == batchCount)
+                m_batches.push_back({ nullptr, sf::FloatRect(), sf::VertexArray(sf::Quads) });
+
+            Batch& batch = m_batches[batchCount++];
+            batch.texture = quad.texture;
+            batch.bounds = quad.bounds;
+            batch.vertices.clear();
+        }
+        else
+        {
+            Batch& batch = m_batches[target_batch];
+            batch.bounds = unite(batch.bounds, quad.bounds);
+        }
+
+        for (const auto& vertex : quad.vertices)
+            m_batches[target_batch].vertices.append(vertex);
+    }
+
+    for (size_t idx = 0; idx < batchCount; ++idx)
+    {
+        sf::RenderStates states;
+        states.texture = m_batches[idx].texture;
+        target.draw(m_batches[idx].vertices, states);
+    }
+
+    m_drawCallCount = batchCount;
+    m_quadCount = m_quads.size();
+    m_quads.clear();
+}
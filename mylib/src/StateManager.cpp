@@ -94,7 +94,7 @@ void IdleState::exitState()
 
 void IdleState::configureAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(m_owner->getComponent("AnimationComponent"));
+    auto animation_component = m_owner->getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -118,7 +118,7 @@ void IdleState::configureAnimation()
 
 void IdleState::playStateAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(m_owner->getComponent("AnimationComponent"));
+    auto animation_component = m_owner->getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -220,7 +220,7 @@ void RunState::exitState()
 
 void RunState::configureAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(m_owner->getComponent("AnimationComponent"));
+    auto animation_component = m_owner->getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -244,7 +244,7 @@ void RunState::configureAnimation()
 
 void RunState::playStateAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(m_owner->getComponent("AnimationComponent"));
+    auto animation_component = m_owner->getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -284,7 +284,7 @@ AttackState::AttackState(Hero* owner)
 
 void AttackState::enterState()
 {
-    auto player_controller = static_cast<PlayerController*>(m_owner->getComponent("PlayerController"));
+    auto player_controller = m_owner->getComponent<PlayerController>();
     if (player_controller)
     {
         m_initialVelocity = sf::Vector2f(0.0f, 0.0f);
@@ -311,7 +311,7 @@ void AttackState::enterState()
         disableMovement();
     }
 
-    auto sound_component = static_cast<SoundComponent*>(m_owner->getComponent("SoundComponent"));
+    auto sound_component = m_owner->getComponent<SoundComponent>();
     if (sound_component)
         sound_component->playAction("attack", 20.f);
 
@@ -333,7 +333,7 @@ void AttackState::update(float deltaTime)
     if (std::abs(m_initialVelocity.x) > 0.5f || std::abs(m_initialVelocity.y) > 0.5f)
         m_owner->move(m_initialVelocity * deltaTime);
 
-    auto animation_component = static_cast<AnimationComponent*>(m_owner->getComponent("AnimationComponent"));
+    auto animation_component = m_owner->getComponent<AnimationComponent>();
     if (animation_component && animation_component->isAnimationFinished())
     {
         bool moving = isGoingLeft() || isGoingRight() || isGoingUp() || isGoingDown();
@@ -351,7 +351,7 @@ void AttackState::exitState()
 
 void AttackState::configureAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(m_owner->getComponent("AnimationComponent"));
+    auto animation_component = m_owner->getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -375,7 +375,7 @@ void AttackState::configureAnimation()
 
 void AttackState::playStateAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(m_owner->getComponent("AnimationComponent"));
+    auto animation_component = m_owner->getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -407,7 +407,7 @@ void AttackState::playStateAnimation()
 
 void AttackState::disableMovement()
 {
-    auto player_controller = static_cast<PlayerController*>(m_owner->getComponent("PlayerController"));
+    auto player_controller = m_owner->getComponent<PlayerController>();
     if (player_controller)
     {
         player_controller->m_isMovingUp = false;
@@ -436,7 +436,7 @@ void ShootState::handleInput()
 
 void ShootState::update(float deltaTime)
 {
-    auto animation_component = static_cast<AnimationComponent*>(m_owner->getComponent("AnimationComponent"));
+    auto animation_component = m_owner->getComponent<AnimationComponent>();
     if (animation_component && animation_component->isAnimationFinished()) 
     {
         bool moving = isGoingLeft() || isGoingRight() || isGoingUp() || isGoingDown();
@@ -454,7 +454,7 @@ void ShootState::exitState()
 
 void ShootState::configureAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(m_owner->getComponent("AnimationComponent"));
+    auto animation_component = m_owner->getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -479,7 +479,7 @@ void ShootState::configureAnimation()
 
 void ShootState::playStateAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(m_owner->getComponent("AnimationComponent"));
+    auto animation_component = m_owner->getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -529,7 +529,7 @@ void HurtState::handleInput()
 void HurtState::update(float deltaTime)
 {
     if (m_animClock.getElapsedTime().asSeconds() >= m_hurtDuration ||
-        static_cast<AnimationComponent*>(m_owner->getComponent("AnimationComponent"))->isAnimationFinished()) 
+        m_owner->getComponent<AnimationComponent>()->isAnimationFinished()) 
     {
         bool moving = isGoingLeft() || isGoingRight() || isGoingUp() || isGoingDown();
 
@@ -546,7 +546,7 @@ void HurtState::exitState()
 
 void HurtState::configureAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(m_owner->getComponent("AnimationComponent"));
+    auto animation_component = m_owner->getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -560,7 +560,7 @@ void HurtState::configureAnimation()
 
 void HurtState::playStateAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(m_owner->getComponent("AnimationComponent"));
+    auto animation_component = m_owner->getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -595,7 +595,7 @@ void DeathState::exitState()
 
 void DeathState::configureAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(m_owner->getComponent("AnimationComponent"));
+    auto animation_component = m_owner->getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
@@ -609,7 +609,7 @@ void DeathState::configureAnimation()
 
 void DeathState::playStateAnimation()
 {
-    auto animation_component = static_cast<AnimationComponent*>(m_owner->getComponent("AnimationComponent"));
+    auto animation_component = m_owner->getComponent<AnimationComponent>();
     if (!animation_component)
         return;
 
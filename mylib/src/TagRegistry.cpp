@@ -0,0 +1,73 @@
+#include "TagRegistry.h"
+
+#include <iostream>
+
+TagRegistry::TagRegistry()
+{
+    for (const char* name : { "", "Player", "Enemy", "Projectile", "Effect", "UI" })
+        internCategory(name);
+
+    for (const char* name : { "Hero", "Arrow", "MeleeEnemy", "RangedEnemy" })
+        internTag(name);
+}
+
+TagId TagRegistry::internCategory(const std::string& name)
+{
+    return m_categories.intern(name, invalid);
+}
+
+TagId TagRegistry::internTag(const std::string& name)
+{
+    TagId tag = m_tags.intern(name, maxTags);
+    if (tag == invalid)
+        std::cerr << "Too many tags, ignoring: " << name << std::endl;
+
+    return tag;
+}
+
+TagId TagRegistry::findCategory(const std::string& name) const
+{
+    return m_categories.find(name);
+}
+
+TagId TagRegistry::findTag(const std::string& name) const
+{
+    return m_tags.find(name);
+}
+
+const std::string& TagRegistry::getCategoryName(TagId category) const
+{
+    return m_categories.getName(category);
+}
+
+const std::string& TagRegistry::getTagName(TagId tag) const
+{
+    return m_tags.getName(tag);
+}
+
+TagId TagRegistry::NameTable::intern(const std::string& name, size_t limit)
+{
+    auto iterator = ids.find(name);
+    if (iterator != ids.end())
+        return iterator->second;
+
+    if (names.size() >= limit)
+        return invalid;
+
+    TagId id = static_cast<TagId>(names.size());
+    ids.emplace(name, id);
+    names.push_back(name);
+    return id;
+}
+
+TagId TagRegistry::NameTable::find(const std::string& name) const
+{
+    auto iterator = ids.find(name);
+    return iterator != ids.end() ? iterator->second : invalid;
+}
+
+const std::string& TagRegistry::NameTable::getName(TagId id) const
+{
+    static const std::string unknown;
+    return id < names.size() ? names[id] : unknown;
+}
@@ -1,8 +1,38 @@
 #include "TextureManager.h"
 #include "PathManager.h"
+#include <algorithm>
 #include <iostream>
 #include <filesystem>
 
+namespace
+{
+    // Transparent border around each atlas image, filled with the image's edge pixels so smooth
+    // sampling at the image border never picks up a neighbour.
+    const unsigned atlasPadding = 2;
+    const unsigned atlasMaxPageSize = 4096;
+
+    struct AtlasImage
+    {
+        std::string name;
+        sf::Image image;
+        unsigned page = 0;
+        sf::Vector2u position;
+    };
+
+    void extrudeEdges(sf::Image& page, const sf::Image& image, const sf::Vector2u& position)
+    {
+        sf::Vector2u size = image.getSize();
+
+        for (unsigned offset = 1; offset <= atlasPadding; ++offset)
+        {
+            page.copy(image, position.x, position.y - offset, sf::IntRect(0, 0, size.x, 1));
+            page.copy(image, position.x, position.y + size.y - 1 + offset, sf::IntRect(0, size.y - 1, size.x, 1));
+            page.copy(image, position.x - offset, position.y, sf::IntRect(0, 0, 1, size.y));
+            page.copy(image, position.x + size.x - 1 + offset, position.y, sf::IntRect(size.x - 1, 0, 1, size.y));
+        }
+    }
+}
+
 TextureManager::TextureManager()
     : m_initialized(false)
 {
@@ -25,6 +55,8 @@ void TextureManager::initialize()
 void TextureManager::cleanup()
 {
     m_textures.clear();
+    m_atlasRegions.clear();
+    m_atlasPages.clear();
     m_initialized = false;
     std::cout << "TextureManager cleaned up" << std::endl;
 }
@@ -54,19 +86,145 @@ bool TextureManager::loadTexture(const std::string& name, const std::string& fil
 
 sf::Texture* TextureManager::getTexture(const std::string& name)
 {
+    return getRegion(name).texture;
+}
+
+TextureRegion TextureManager::getRegion(const std::string& name)
+{
+    auto region = m_atlasRegions.find(name);
+    if (region != m_atlasRegions.end())
+        return region->second;
+
     auto iterator = m_textures.find(name);
     if (iterator != m_textures.end())
     {
-        return iterator->second.get();
+        sf::Vector2u size = iterator->second->getSize();
+        return { iterator->second.get(), sf::IntRect(0, 0, size.x, size.y) };
     }
 
     std::cerr << "Texture not found: " << name << std::endl;
-    return nullptr;
+    return {};
 }
 
 bool TextureManager::hasTexture(const std::string& name) const
 {
-    return m_textures.find(name) != m_textures.end();
+    return m_textures.find(name) != m_textures.end() || m_atlasRegions.find(name) != m_atlasRegions.end();
+}
+
+bool TextureManager::loadAtlas(const std::vector<std::pair<std::string, std::string>>& images)
+{
+    const unsigned pageSize = std::min(atlasMaxPageSize, sf::Texture::getMaximumSize());
+
+    bool success = true;
+    std::vector<AtlasImage> atlasImages;
+    for (const auto& [name, filename] : images)
+    {
+        if (hasTexture(name))
+            continue;
+
+        AtlasImage atlasImage;
+        atlasImage.name = name;
+
+        std::string fullPath = PathManager::getResourcePath(filename);
+        if (!atlasImage.image.loadFromFile(fullPath))
+        {
+            std::cerr << "Failed to load texture: " << fullPath << std::endl;
+            success = false;
+            continue;
+        }
+
+        sf::Vector2u size = atlasImage.image.getSize();
+        if (size.x + 2 * atlasPadding > pageSize || size.y + 2 * atlasPadding > pageSize)
+        {
+            success = loadTexture(name, filename) && success;
+            continue;
+        }
+
+        atlasImages.push_back(std::move(atlasImage));
+    }
+
+    if (atlasImages.empty())
+        return success;
+
+    // Shelf packing, tallest images first: each shelf is as tall as its first image and gets
+    // filled left to right until the page width runs out.
+    std::sort(atlasImages.begin(), atlasImages.end(),
+        [](const AtlasImage& first, const AtlasImage& second)
+        {
+            return first.image.getSize().y > second.image.getSize().y;
+        });
+
+    unsigned firstPage = static_cast<unsigned>(m_atlasPages.size());
+    std::vector<sf::Vector2u> pageSizes(1);
+    unsigned cursorX = 0;
+    unsigned shelfY = 0;
+    unsigned shelfHeight = 0;
+
+    for (auto& atlasImage : atlasImages)
+    {
+        sf::Vector2u cellSize = atlasImage.image.getSize() + sf::Vector2u(2 * atlasPadding, 2 * atlasPadding);
+
+        if (cursorX + cellSize.x > pageSize)
+        {
+            cursorX = 0;
+            shelfY += shelfHeight;
+            shelfHeight = 0;
+        }
+
+        if (shelfY + cellSize.y > pageSize)
+        {
+            pageSizes.emplace_back();
+            cursorX = 0;
+            shelfY = 0;
+            shelfHeight = 0;
+        }
+
+        atlasImage.page = static_cast<unsigned>(pageSizes.size() - 1);
+        atlasImage.position = sf::Vector2u(cursorX + atlasPadding, shelfY + atlasPadding);
+
+        cursorX += cellSize.x;
+        shelfHeight = std::max(shelfHeight, cellSize.y);
+
+        sf::Vector2u& usedSize = pageSizes.back();
+        usedSize.x = std::max(usedSize.x, cursorX);
+        usedSize.y = std::max(usedSize.y, shelfY + shelfHeight);
+    }
+
+    std::vector<sf::Image> pageImages(pageSizes.size());
+    for (size_t page = 0; page < pageSizes.size(); ++page)
+        pageImages[page].create(pageSizes[page].x, pageSizes[page].y, sf::Color::Transparent);
+
+    for (const auto& atlasImage : atlasImages)
+    {
+        sf::Image& pageImage = pageImages[atlasImage.page];
+        pageImage.copy(atlasImage.image, atlasImage.position.x, atlasImage.position.y);
+        extrudeEdges(pageImage, atlasImage.image, atlasImage.position);
+    }
+
+    for (size_t page = 0; page < pageImages.size(); ++page)
+    {
+        auto texture = std::make_unique<sf::Texture>();
+        if (!texture->loadFromImage(pageImages[page]))
+        {
+            std::cerr << "Failed to create atlas page " << firstPage + page << std::endl;
+            return false;
+        }
+
+        texture->setSmooth(true);
+        m_atlasPages.push_back(std::move(texture));
+
+        std::cout << "Created atlas page " << firstPage + page << " (" << pageSizes[page].x << "x" << pageSizes[page].y << ")" << std::endl;
+    }
+
+    for (const auto& atlasImage : atlasImages)
+    {
+        sf::Vector2u size = atlasImage.image.getSize();
+        TextureRegion& region = m_atlasRegions[atlasImage.name];
+        region.texture = m_atlasPages[firstPage + atlasImage.page].get();
+        region.rect = sf::IntRect(atlasImage.position.x, atlasImage.position.y, size.x, size.y);
+    }
+
+    return success;
 }
 
 void TextureManager::loadAllGameTextures()
@@ -74,12 +232,16 @@ void TextureManager::loadAllGameTextures()
     if (!m_initialized)
         initialize();
 
-    loadTexture("player", "hero\\player.png");
-    loadTexture("enemy", "enemy\\enemy.png");
-    loadTexture("arrow", "projectile\\arrow.png");
-    loadTexture("blood", "effect\\blood.png");
-    loadTexture("hero_icons", "hud\\hero_icons.png");
-    loadTexture("health_bar_template", "hud\\health_bar_template.png");
+    loadAtlas({
+        { "player", "hero\\player.png" },
+        { "enemy", "enemy\\enemy.png" },
+        { "arrow", "projectile\\arrow.png" },
+        { "blood", "effect\\blood.png" },
+        { "hero_icons", "hud\\hero_icons.png" },
+        { "health_bar_template", "hud\\health_bar_template.png" },
+        { "herbe2", "Map\\herbe2.png" },
+        { "chemins", "Map\\chemins.png" }
+    });
 
     std::cout << "All game textures loaded successfully\n";
 }
\ No newline at end of file
@@ -1,9 +1,14 @@
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include "Map.h"
 #include "Tiles.h"
 
 TilesMap::TilesMap(const std::string& name, const MapRepresentation& repr, int tileSize)
     : CompositeGameObject(name)
 {
+    setKind(Kind);
+
     m_width = static_cast<int>(repr[0].size());
     m_height = static_cast<int>(repr.size());
     m_tileSize = tileSize;
@@ -21,6 +26,11 @@ TilesMap::TilesMap(const std::string& name, const MapRepresentation& repr, int t
     }
 }
 
+TilesMap::~TilesMap()
+{
+    WorldLimits::removeSolidMap(this);
+}
+
 void TilesMap::addLayer(const MapRepresentation& repr, int tileSize)
 {
     int layerWidth = static_cast<int>(repr[0].size());
@@ -39,6 +49,7 @@ void TilesMap::addLayer(const MapRepresentation& repr, int tileSize)
     }
 
     m_layers.push_back(newLayer);
+    markAllPagesDirty();
 }
 
 void TilesMap::setLayerVisibility(int layerIndex, bool visible)
@@ -46,117 +57,237 @@ void TilesMap::setLayerVisibility(int layerIndex, bool visible)
     if (layerIndex >= 0 && layerIndex < m_layers.size())
     {
         m_layers[layerIndex].visible = visible;
+        markAllPagesDirty();
     }
 }
 
 void TilesMap::render(sf::RenderWindow& w)
 {
-    TextureManager& texManager = TextureManager::getInstance();
+    const sf::View& view = w.getView();
+    sf::Vector2f viewCenter = view.getCenter();
+    sf::Vector2f viewSize = view.getSize();
+    sf::FloatRect viewArea(viewCenter - viewSize / 2.0f, viewSize);
+
+    if (isStaticCacheEnabled() && renderPages(w, viewArea))
+        return;
 
-    if (!texManager.hasTexture("herbe2"))
+    renderChunks(w, viewArea);
+}
+
+void TilesMap::renderChunks(sf::RenderTarget& target, const sf::FloatRect& area)
+{
+    for (int layerIndex = 0; layerIndex < m_layers.size(); ++layerIndex)
     {
-        texManager.loadTexture("herbe2", "Map\\herbe2.png");
+        Layer& layer = m_layers[layerIndex];
+        if (!layer.visible)
+            continue;
+
+        TextureRegion region = getLayerTexture(layerIndex);
+        if (!region.texture)
+        {
+            std::cerr << "Error: Texture not found for layer " << layerIndex << std::endl;
+            continue;
+        }
+
+        if (layer.chunks.empty())
+            createChunks(layer);
+
+        sf::Vector2f chunkSize = getLayerTileSize(layerIndex) * static_cast<float>(chunkTiles);
+
+        int startCol = clamp(0, layer.chunkColumns - 1, static_cast<int>(std::floor(area.left / chunkSize.x)));
+        int endCol = clamp(0, layer.chunkColumns - 1, static_cast<int>(std::floor((area.left + area.width) / chunkSize.x)));
+        int startRow = clamp(0, layer.chunkRows - 1, static_cast<int>(std::floor(area.top / chunkSize.y)));
+        int endRow = clamp(0, layer.chunkRows - 1, static_cast<int>(std::floor((area.top + area.height) / chunkSize.y)));
+
+        sf::RenderStates states;
+        states.texture = region.texture;
+
+        for (int chunkRow = startRow; chunkRow <= endRow; ++chunkRow)
+        {
+            for (int chunkCol = startCol; chunkCol <= endCol; ++chunkCol)
+            {
+                Chunk& chunk = layer.chunks[chunkRow * layer.chunkColumns + chunkCol];
+                if (chunk.dirty)
+                    buildChunk(layerIndex, chunkRow, chunkCol, region.rect);
+
+                if (chunk.vertices.getVertexCount() > 0)
+                    target.draw(chunk.vertices, states);
+            }
+        }
     }
+}
+
+void TilesMap::enableStaticCache(unsigned pageSize, size_t pageBudget)
+{
+    disableStaticCache();
 
-    if (!texManager.hasTexture("chemins"))
+    m_pageSize = std::min(pageSize, sf::Texture::getMaximumSize());
+    m_pageBudget = pageBudget;
+}
+
+void TilesMap::disableStaticCache()
+{
+    m_pageSize = 0;
+    m_pageBudget = 0;
+    m_pages.clear();
+    m_visiblePages.clear();
+    m_pagesDirty = true;
+}
+
+sf::Vector2f TilesMap::getPixelSize() const
+{
+    sf::Vector2f size;
+    for (int layerIndex = 0; layerIndex < static_cast<int>(m_layers.size()); ++layerIndex)
     {
-        texManager.loadTexture("chemins", "Map\\chemins.png");
+        sf::Vector2f tileSize = getLayerTileSize(layerIndex);
+        int layerHeight = static_cast<int>(m_layers[layerIndex].tiles.size() / m_width);
+
+        size.x = std::max(size.x, m_width * tileSize.x);
+        size.y = std::max(size.y, layerHeight * tileSize.y);
     }
+    return size;
+}
 
-    sf::View view = w.getView();
-    sf::Vector2f viewCenter = view.getCenter();
-    sf::Vector2f viewSize = view.getSize();
+bool TilesMap::renderPages(sf::RenderWindow& w, const sf::FloatRect& viewArea)
+{
+    sf::Vector2f pixelSize = getPixelSize();
+    float pageSize = static_cast<float>(m_pageSize);
+    int pageColumns = static_cast<int>(std::ceil(pixelSize.x / pageSize));
+    int pageRows = static_cast<int>(std::ceil(pixelSize.y / pageSize));
 
-    for (int layerIndex = 0; layerIndex < m_layers.size(); ++layerIndex)
+    int startCol = clamp(0, pageColumns - 1, static_cast<int>(std::floor(viewArea.left / pageSize)));
+    int endCol = clamp(0, pageColumns - 1, static_cast<int>(std::floor((viewArea.left + viewArea.width) / pageSize)));
+    int startRow = clamp(0, pageRows - 1, static_cast<int>(std::floor(viewArea.top / pageSize)));
+    int endRow = clamp(0, pageRows - 1, static_cast<int>(std::floor((viewArea.top + viewArea.height) / pageSize)));
+
+    sf::IntRect pageRange(startCol, startRow, endCol - startCol + 1, endRow - startRow + 1);
+    if (static_cast<size_t>(pageRange.width) * pageRange.height > m_pageBudget)
+        return false;
+
+    if (m_pagesDirty || pageRange != m_visiblePageRange)
+        refreshPages(pageRange);
+
+    for (Page* page : m_visiblePages)
     {
-        if (!m_layers[layerIndex].visible)
-            continue;
+        sf::Sprite sprite(page->target->getTexture());
+        sprite.setPosition(page->coordinate.x * pageSize, page->coordinate.y * pageSize);
+        w.draw(sprite);
+    }
 
-        int layerTileSize = m_layers[layerIndex].tileSize;
-        float scaleFactor = (layerTileSize == 32) ? m_scale.x : 1.0f;
-        float scaledTileSize = layerTileSize * scaleFactor;
+    return true;
+}
 
-        sf::Texture* texture = nullptr;
-        if (layerTileSize == 16)
+void TilesMap::refreshPages(const sf::IntRect& pageRange)
+{
+    ++m_pageRefreshCount;
+    m_visiblePageRange = pageRange;
+    m_visiblePages.clear();
+
+    // Keep the pages still in view and note the ones to bring in, then hand those the slots of
+    // pages that scrolled out longest ago.
+    std::vector<sf::Vector2i> missing;
+    for (int row = pageRange.top; row < pageRange.top + pageRange.height; ++row)
+    {
+        for (int col = pageRange.left; col < pageRange.left + pageRange.width; ++col)
         {
-            texture = texManager.getTexture("herbe2");
+            sf::Vector2i coordinate(col, row);
+            auto it = std::find_if(m_pages.begin(), m_pages.end(),
+                [&coordinate](const Page& page) { return page.coordinate == coordinate; });
+
+            if (it == m_pages.end())
+            {
+                missing.push_back(coordinate);
+                continue;
+            }
+
+            it->lastSeen = m_pageRefreshCount;
+            if (it->dirty)
+                renderPage(*it);
         }
-        else if (layerTileSize == 32)
+    }
+
+    for (const auto& coordinate : missing)
+    {
+        Page* page = nullptr;
+        if (m_pages.size() < m_pageBudget)
         {
-            texture = texManager.getTexture("chemins");
+            m_pages.emplace_back();
+            page = &m_pages.back();
+            page->target = std::make_unique<sf::RenderTexture>();
+            if (!page->target->create(m_pageSize, m_pageSize))
+            {
+                std::cerr << "Error: Could not create a " << m_pageSize << "px map page, disabling the static cache" << std::endl;
+                disableStaticCache();
+                return;
+            }
         }
-
-        if (!texture)
+        else
         {
-            std::cerr << "Error: Texture not found for layer " << layerIndex << std::endl;
-            continue;
+            auto oldest = std::min_element(m_pages.begin(), m_pages.end(),
+                [](const Page& lhs, const Page& rhs) { return lhs.lastSeen < rhs.lastSeen; });
+            page = &*oldest;
         }
 
-        sf::Sprite sprite;
-        sprite.setTexture(*texture);
+        page->coordinate = coordinate;
+        page->lastSeen = m_pageRefreshCount;
+        renderPage(*page);
+    }
+
+    // Pointers are taken last since creating pages may have moved the vector.
+    for (auto& page : m_pages)
+    {
+        if (page.lastSeen == m_pageRefreshCount)
+            m_visiblePages.push_back(&page);
+    }
 
-        if (layerTileSize == 32)
-            sprite.setScale(m_scale);
+    m_pagesDirty = false;
+}
 
-        int layerWidth = m_width;
-        int layerHeight = static_cast<int>(m_layers[layerIndex].tiles.size() / layerWidth);
+void TilesMap::renderPage(Page& page)
+{
+    float pageSize = static_cast<float>(m_pageSize);
+    sf::FloatRect area(page.coordinate.x * pageSize, page.coordinate.y * pageSize, pageSize, pageSize);
 
-        int startRow = clamp(0, layerHeight - 1, static_cast<int>((viewCenter.y - viewSize.y / 2) / scaledTileSize));
-        int endRow = clamp(0, layerHeight - 1, static_cast<int>((viewCenter.y + viewSize.y / 2) / scaledTileSize) + 1);
-        int startCol = clamp(0, layerWidth - 1, static_cast<int>((viewCenter.x - viewSize.x / 2) / scaledTileSize));
-        int endCol = clamp(0, layerWidth - 1, static_cast<int>((viewCenter.x + viewSize.x / 2) / scaledTileSize) + 1);
+    page.target->setView(sf::View(area));
+    page.target->clear(sf::Color::Transparent);
+    renderChunks(*page.target, area);
+    page.target->display();
 
-        startRow = std::max(0, startRow - 1);
-        endRow = std::min(layerHeight - 1, endRow + 1);
-        startCol = std::max(0, startCol - 1);
-        endCol = std::min(layerWidth - 1, endCol + 1);
+    page.dirty = false;
+}
 
-        for (int row = startRow; row <= endRow; ++row)
+void TilesMap::markPagesDirty(const sf::FloatRect& area)
+{
+    float pageSize = static_cast<float>(m_pageSize);
+    for (auto& page : m_pages)
+    {
+        sf::FloatRect pageArea(page.coordinate.x * pageSize, page.coordinate.y * pageSize, pageSize, pageSize);
+        if (pageArea.intersects(area))
         {
-            for (int col = startCol; col <= endCol; ++col)
-            {
-                try
-                {
-                    if (row >= layerHeight || col >= layerWidth || row < 0 || col < 0)
-                        continue;
-
-                    TileType tileType = m_layers[layerIndex].tiles[row * layerWidth + col];
-
-                    if (tileType == ' ' || tileType == '.')
-                        continue;
-
-                    sf::Vector2i tileCoords = getTileCoordinateInTexture(tileType);
-
-                    sprite.setTextureRect(sf::IntRect(
-                        tileCoords.x * layerTileSize,
-                        tileCoords.y * layerTileSize,
-                        layerTileSize,
-                        layerTileSize
-                    ));
-
-                    if (layerTileSize == 32)
-                    {
-                        float posX = static_cast<float>(col * layerTileSize * m_scale.x);
-                        float posY = static_cast<float>(row * layerTileSize * m_scale.y);
-                        sprite.setPosition(posX, posY);
-                    }
-                    else
-                    {
-                        float posX = static_cast<float>(col * layerTileSize);
-                        float posY = static_cast<float>(row * layerTileSize);
-                        sprite.setPosition(posX, posY);
-                    }
-                    w.draw(sprite);
-                }
-                catch (const std::exception& e)
-                {
-                    std::cerr << "Error rendering tile at layer " << layerIndex << " (" << row << "," << col << "): " << e.what() << std::endl;
-                }
-            }
+            page.dirty = true;
+            m_pagesDirty = true;
         }
     }
 }
+
+void TilesMap::markAllPagesDirty()
+{
+    for (auto& page : m_pages)
+        page.dirty = true;
+
+    m_pagesDirty = true;
+}
+
 sf::Vector2i TilesMap::getTileCoordinateInTexture(const TileType& tile)
+{
+    sf::Vector2i coordinate;
+    if (!findTileCoordinateInTexture(tile, coordinate))
+        throw std::runtime_error("Tile type not found: " + std::string(1, tile));
+
+    return coordinate;
+}
+
+bool TilesMap::findTileCoordinateInTexture(TileType tile, sf::Vector2i& coordinate) const
 {
     static std::map<TileType, sf::Vector2i> tileMap16 = {
          {'H', {4, 6}}
@@ -185,19 +316,113 @@ sf::Vector2i TilesMap::getTileCoordinateInTexture(const TileType& tile)
 
     auto it16 = tileMap16.find(tile);
     if (it16 != tileMap16.end())
-        return it16->second;
+    {
+        coordinate = it16->second;
+        return true;
+    }
 
     auto it32 = tileMap32.find(tile);
     if (it32 != tileMap32.end())
-        return it32->second;
+    {
+        coordinate = it32->second;
+        return true;
+    }
 
-    throw std::runtime_error("Tile type not found: " + std::string(1, tile));
+    return false;
+}
+
+TextureRegion TilesMap::getLayerTexture(int layerIndex)
+{
+    TextureManager& texManager = TextureManager::getInstance();
+
+    if (m_layers[layerIndex].tileSize == 16)
+    {
+        if (!texManager.hasTexture("herbe2"))
+            texManager.loadTexture("herbe2", "Map\\herbe2.png");
+
+        return texManager.getRegion("herbe2");
+    }
+
+    if (m_layers[layerIndex].tileSize == 32)
+    {
+        if (!texManager.hasTexture("chemins"))
+            texManager.loadTexture("chemins", "Map\\chemins.png");
+
+        return texManager.getRegion("chemins");
+    }
+
+    return {};
+}
+
+void TilesMap::createChunks(Layer& layer)
+{
+    int layerHeight = static_cast<int>(layer.tiles.size() / m_width);
+
+    layer.chunkColumns = (m_width + chunkTiles - 1) / chunkTiles;
+    layer.chunkRows = (layerHeight + chunkTiles - 1) / chunkTiles;
+    layer.chunks.assign(layer.chunkColumns * layer.chunkRows, Chunk());
+}
+
+void TilesMap::markAllChunksDirty()
+{
+    for (auto& layer : m_layers)
+    {
+        for (auto& chunk : layer.chunks)
+            chunk.dirty = true;
+    }
+}
+
+void TilesMap::buildChunk(int layerIndex, int chunkRow, int chunkCol, const sf::IntRect& textureRegion)
+{
+    Layer& layer = m_layers[layerIndex];
+    Chunk& chunk = layer.chunks[chunkRow * layer.chunkColumns + chunkCol];
+
+    int layerHeight = static_cast<int>(layer.tiles.size() / m_width);
+    int startRow = chunkRow * chunkTiles;
+    int endRow = std::min(layerHeight, startRow + chunkTiles);
+    int startCol = chunkCol * chunkTiles;
+    int endCol = std::min(m_width, startCol + chunkTiles);
+
+    sf::Vector2f tileSize = getLayerTileSize(layerIndex);
+    float textureTileSize = static_cast<float>(layer.tileSize);
+
+    chunk.vertices.clear();
+
+    for (int row = startRow; row < endRow; ++row)
+    {
+        for (int col = startCol; col < endCol; ++col)
+        {
+            TileType tileType = layer.tiles[row * m_width + col];
+            if (tileType == ' ' || tileType == '.')
+                continue;
+
+            sf::Vector2i tileCoords;
+            if (!findTileCoordinateInTexture(tileType, tileCoords))
+            {
+                std::cerr << "Tile type not found at layer " << layerIndex << " (" << row << "," << col << "): " << tileType << std::endl;
+                continue;
+            }
+
+            sf::Vector2f position(col * tileSize.x, row * tileSize.y);
+            sf::Vector2f texturePosition(textureRegion.left + tileCoords.x * textureTileSize, textureRegion.top + tileCoords.y * textureTileSize);
+
+            chunk.vertices.append(sf::Vertex(position, texturePosition));
+            chunk.vertices.append(sf::Vertex(position + sf::Vector2f(tileSize.x, 0.0f), texturePosition + sf::Vector2f(textureTileSize, 0.0f)));
+            chunk.vertices.append(sf::Vertex(position + tileSize, texturePosition + sf::Vector2f(textureTileSize, textureTileSize)));
+            chunk.vertices.append(sf::Vertex(position + sf::Vector2f(0.0f, tileSize.y), texturePosition + sf::Vector2f(0.0f, textureTileSize)));
+        }
+    }
+
+    chunk.dirty = false;
 }
 
 void TilesMap::setScale(float scaleX, float scaleY)
 {
     m_scale.x = scaleX;
     m_scale.y = scaleY;
+
+    markAllChunksDirty();
+    markAllPagesDirty();
 }
 
 int TilesMap::clamp(int min, int max, int val)
@@ -216,5 +441,76 @@ void TilesMap::setTile(int layerIndex, int row, int col, TileType tileType)
         col >= 0 && col < m_width)
     {
         getTile(layerIndex, row, col) = tileType;
+
+        Layer& layer = m_layers[layerIndex];
+        if (!layer.chunks.empty())
+            layer.chunks[(row / chunkTiles) * layer.chunkColumns + col / chunkTiles].dirty = true;
+
+        sf::Vector2f tileSize = getLayerTileSize(layerIndex);
+        markPagesDirty(sf::FloatRect(col * tileSize.x, row * tileSize.y, tileSize.x, tileSize.y));
+    }
+}
+
+void TilesMap::setTileSolid(int layerIndex, TileType tileType, bool solid)
+{
+    if (layerIndex < 0 || layerIndex >= static_cast<int>(m_layers.size()))
+        return;
+
+    Layer& layer = m_layers[layerIndex];
+    layer.solid[static_cast<unsigned char>(tileType)] = solid;
+    layer.hasSolid = std::find(layer.solid.begin(), layer.solid.end(), true) != layer.solid.end();
+}
+
+bool TilesMap::isTileSolid(int layerIndex, int row, int col) const
+{
+    if (layerIndex < 0 || layerIndex >= static_cast<int>(m_layers.size()))
+        return false;
+
+    const Layer& layer = m_layers[layerIndex];
+    int layerHeight = static_cast<int>(layer.tiles.size() / m_width);
+
+    if (row < 0 || row >= layerHeight || col < 0 || col >= m_width)
+        return false;
+
+    return layer.solid[static_cast<unsigned char>(layer.tiles[row * m_width + col])];
+}
+
+bool TilesMap::isAreaSolid(const sf::FloatRect& area) const
+{
+    for (int layerIndex = 0; layerIndex < static_cast<int>(m_layers.size()); ++layerIndex)
+    {
+        const Layer& layer = m_layers[layerIndex];
+        if (!layer.hasSolid)
+            continue;
+
+        sf::Vector2f tileSize = getLayerTileSize(layerIndex);
+        int layerHeight = static_cast<int>(layer.tiles.size() / m_width);
+
+        int startCol = std::max(0, static_cast<int>(std::floor(area.left / tileSize.x)));
+        int endCol = std::min(m_width - 1, static_cast<int>(std::floor((area.left + area.width) / tileSize.x)));
+        int startRow = std::max(0, static_cast<int>(std::floor(area.top / tileSize.y)));
+        int endRow = std::min(layerHeight - 1, static_cast<int>(std::floor((area.top + area.height) / tileSize.y)));
+
+        for (int row = startRow; row <= endRow; ++row)
+        {
+            for (int col = startCol; col <= endCol; ++col)
+            {
+                if (layer.solid[static_cast<unsigned char>(layer.tiles[row * m_width + col])])
+                    return true;
+            }
+        }
     }
-}
\ No newline at end of file
+
+    return false;
+}
+
+sf::Vector2f TilesMap::getLayerTileSize(int layerIndex) const
+{
+    float tileSize = static_cast<float>(m_layers[layerIndex].tileSize);
+
+    // Matches render: only the 32px layers are drawn scaled.
+    if (m_layers[layerIndex].tileSize == 32)
+        return sf::Vector2f(tileSize * m_scale.x, tileSize * m_scale.y);
+
+    return sf::Vector2f(tileSize, tileSize);
+}
@@ -1,14 +1,18 @@
 #include "UI.h"
 
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 
+#include "AllocationCounter.h"
+#include "CollisionProfiler.h"
 #include "PathManager.h"
+#include "SpriteBatch.h"
 #include "TextureManager.h"
 #include "Game.h"
 
 HealthUI::HealthUI(const std::string& name)
     : CompositeGameObject(name)
-    , m_hero(nullptr)
     , m_currentIconState(HeroIconState::Neutral)
     , m_healthBarSize(200.f, 20.f)
     , m_healthBarOffset(75.f, 10.f)
@@ -21,7 +25,7 @@ HealthUI::HealthUI(const std::string& name)
     , m_lastHealth(100)
     , m_scale(0.5f)
 {
-    setCategory("UI");
+    setCategory(Category::UI);
 }
 
 void HealthUI::initialize(Hero* hero, float scale)
@@ -29,8 +33,8 @@ void HealthUI::initialize(Hero* hero, float scale)
     if (!hero)
         return;
 
-    m_hero = hero;
-    m_lastHealth = m_hero->getHealth();
+    m_hero = hero->getHandle();
+    m_lastHealth = hero->getHealth();
     m_scale = scale;
 
     loadTextures();
@@ -52,47 +56,49 @@ void HealthUI::initialize(Hero* hero, float scale)
 
 void HealthUI::loadTextures()
 {
-    sf::Texture* originalBarTexture = TextureManager::getInstance().getTexture("health_bar_template");
-    if (originalBarTexture)
+    TextureRegion originalBarRegion = TextureManager::getInstance().getRegion("health_bar_template");
+    if (originalBarRegion.texture)
     {
-        sf::Vector2u originalSize = originalBarTexture->getSize();
+        sf::Vector2i originalSize(originalBarRegion.rect.width, originalBarRegion.rect.height);
 
         sf::RenderTexture renderTexture;
         if (renderTexture.create(originalSize.x / 4, originalSize.y / 4))
         {
             renderTexture.clear(sf::Color::Transparent);
 
-            sf::Sprite tempSprite(*originalBarTexture);
+            sf::Sprite tempSprite(*originalBarRegion.texture, originalBarRegion.rect);
             tempSprite.setScale(0.25f, 0.25f);
             renderTexture.draw(tempSprite);
             renderTexture.display();
         }
     }
 
-    sf::Texture* barTexture = TextureManager::getInstance().getTexture("health_bar_template");
-    if (barTexture)
+    TextureRegion barRegion = TextureManager::getInstance().getRegion("health_bar_template");
+    if (barRegion.texture)
     {
-        m_healthBarBackground.setTexture(*barTexture);
+        m_healthBarBackground.setTexture(*barRegion.texture);
+        m_healthBarBackground.setTextureRect(barRegion.rect);
 
-        sf::Vector2u textureSize = barTexture->getSize();
+        sf::Vector2i textureSize(barRegion.rect.width, barRegion.rect.height);
         m_healthBarSize.x = static_cast<float>(textureSize.x - m_healthBarOffset.x * 0.5f);
         m_healthBarSize.y = static_cast<float>(textureSize.y - m_healthBarOffset.y * 0.5f);
 
         m_healthBarBackground.setOrigin(0, textureSize.y / 2.0f);
     }
 
-    sf::Texture* iconsTexture = TextureManager::getInstance().getTexture("hero_icons");
-    if (iconsTexture)
+    TextureRegion iconsRegion = TextureManager::getInstance().getRegion("hero_icons");
+    if (iconsRegion.texture)
     {
-        m_heroIcon.setTexture(*iconsTexture);
+        m_heroIcon.setTexture(*iconsRegion.texture);
 
-        sf::Vector2u textureSize = iconsTexture->getSize();
-        int iconSize = textureSize.y;
+        int iconSize = iconsRegion.rect.height;
+        int left = iconsRegion.rect.left;
+        int top = iconsRegion.rect.top;
 
         m_iconFrames.clear();
-        m_iconFrames.push_back(sf::IntRect(0, 0, iconSize, iconSize)); // Neutral
-        m_iconFrames.push_back(sf::IntRect(iconSize, 0, iconSize, iconSize)); // Damaged
-        m_iconFrames.push_back(sf::IntRect(iconSize * 2, 0, iconSize, iconSize)); // Dead
+        m_iconFrames.push_back(sf::IntRect(left, top, iconSize, iconSize)); // Neutral
+        m_iconFrames.push_back(sf::IntRect(left + iconSize, top, iconSize, iconSize)); // Damaged
+        m_iconFrames.push_back(sf::IntRect(left + iconSize * 2, top, iconSize, iconSize)); // Dead
 
         m_heroIcon.setTextureRect(m_iconFrames[0]);
 
@@ -105,10 +111,11 @@ void HealthUI::loadTextures()
 
 void HealthUI::update(const float& deltaTime)
 {
-    if (!m_hero)
+    Hero* hero = CompositeGameObject::resolve<Hero>(m_hero);
+    if (!hero)
         return;
 
-    int currentHealth = m_hero->getHealth();
+    int currentHealth = hero->getHealth();
 
     if (currentHealth < m_lastHealth)
     {
@@ -131,9 +138,9 @@ void HealthUI::update(const float& deltaTime)
 
     updateHealthBar();
 
-    if (!m_hero->isAlive() && m_currentIconState != HeroIconState::Dead)
+    if (!hero->isAlive() && m_currentIconState != HeroIconState::Dead)
         changeHeroIcon(HeroIconState::Dead);
-    else if (m_hero->isAlive() && !m_isDamageAnimationPlaying && m_currentIconState != HeroIconState::Neutral)
+    else if (hero->isAlive() && !m_isDamageAnimationPlaying && m_currentIconState != HeroIconState::Neutral)
         updateIconState();
 
     CompositeGameObject::update(deltaTime);
@@ -184,10 +191,11 @@ sf::Vector2f HealthUI::getPosition() const
 
 void HealthUI::updateHealthBar()
 {
-    if (!m_hero)
+    Hero* hero = CompositeGameObject::resolve<Hero>(m_hero);
+    if (!hero)
         return;
 
-    float newHealthPercentage = m_hero->getHealthPercentage();
+    float newHealthPercentage = hero->getHealthPercentage();
 
     float scaledWidth = m_healthBarSize.x * m_scale;
     float scaledHeight = m_healthBarSize.y * m_scale;
@@ -224,10 +232,11 @@ void HealthUI::updateHealthBar()
 
 void HealthUI::updateIconState()
 {
-    if (!m_hero)
+    Hero* hero = CompositeGameObject::resolve<Hero>(m_hero);
+    if (!hero)
         return;
 
-    if (!m_hero->isAlive())
+    if (!hero->isAlive())
     {
         if (m_currentIconState != HeroIconState::Dead)
             changeHeroIcon(HeroIconState::Dead);
@@ -270,7 +279,7 @@ ScoreUI::ScoreUI(const std::string& name)
     , m_scale(0.5f)
     , m_lastScore(0)
 {
-    setCategory("UI");
+    setCategory(Category::UI);
 }
 
 void ScoreUI::initialize(Game* game, float scale)
@@ -344,4 +353,168 @@ sf::Vector2f ScoreUI::getPosition() const
 void ScoreUI::updateScoreText()
 {
     m_scoreText.setString("Score: " + std::to_string(m_lastScore));
-}
\ No newline at end of file
+}
+
+CollisionStatsUI::CollisionStatsUI(const std::string& name)
+    : CompositeGameObject(name)
+    , m_position(10.f, 90.f)
+    , m_visible(false)
+    , m_refreshInterval(0.25f)
+    , m_refreshTimer(0.f)
+    , m_framesSinceRefresh(0)
+    , m_allocationsAtRefresh(0)
+{
+    setCategory(Category::UI);
+}
+
+void CollisionStatsUI::initialize(float refreshInterval)
+{
+    m_refreshInterval = refreshInterval;
+
+    loadFont();
+
+    m_statsText.setFont(m_font);
+    m_statsText.setCharacterSize(14);
+    m_statsText.setFillColor(sf::Color::White);
+
+    m_background.setFillColor(sf::Color(0, 0, 0, 170));
+
+    setPosition(m_position);
+}
+
+void CollisionStatsUI::loadFont()
+{
+    try
+    {
+        std::string fontPath = PathManager::getResourcePath("font.ttf");
+        if (!m_font.loadFromFile(fontPath))
+            std::cerr << "Failed to load font from: " << fontPath << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Error loading font: " << e.what() << std::endl;
+    }
+}
+
+void CollisionStatsUI::update(const float& deltaTime)
+{
+    if (m_visible)
+    {
+        ++m_framesSinceRefresh;
+        m_refreshTimer += deltaTime;
+        if (m_refreshTimer >= m_refreshInterval)
+        {
+            m_refreshTimer = 0.f;
+            updateStatsText();
+        }
+    }
+
+    CompositeGameObject::update(deltaTime);
+}
+
+void CollisionStatsUI::render(sf::RenderWindow& window)
+{
+    if (!m_visible)
+        return;
+
+    window.draw(m_background);
+    window.draw(m_statsText);
+    CompositeGameObject::render(window);
+}
+
+void CollisionStatsUI::setVisible(bool visible)
+{
+    m_visible = visible;
+
+    if (m_visible)
+    {
+        m_refreshTimer = 0.f;
+        updateStatsText();
+    }
+}
+
+bool CollisionStatsUI::isVisible() const
+{
+    return m_visible;
+}
+
+void CollisionStatsUI::toggle()
+{
+    setVisible(!m_visible);
+}
+
+void CollisionStatsUI::setPosition(const sf::Vector2f& position)
+{
+    m_position = position;
+    m_statsText.setPosition(m_position);
+    m_background.setPosition(m_position - sf::Vector2f(6.f, 6.f));
+}
+
+void CollisionStatsUI::dumpCsv(const std::string& fileName)
+{
+    if (CollisionProfiler::getInstance().dumpCsv(fileName))
+        std::cout << "Collision profile written to " << fileName << std::endl;
+    else
+        std::cerr << "Failed to write collision profile to " << fileName << std::endl;
+}
+
+void CollisionStatsUI::updateStatsText()
+{
+    // Read before anything below allocates, and re-based once the text is built, so the overlay's
+    // own strings never show up in the count.
+    unsigned long long allocations = AllocationCounter::getAllocationCount() - m_allocationsAtRefresh;
+
+    const CollisionProfiler& profiler = CollisionProfiler::getInstance();
+    const CollisionStepStats& last = profiler.getLast();
+    CollisionStepStats average = profiler.getAverage();
+    CollisionStepStats peak = profiler.getPeak();
+
+    std::ostringstream text;
+    text << "Collision step " << last.step << " (" << profiler.getRecordedCount() << " recorded)\n";
+    text << std::left << std::setw(14) << "" << std::right
+        << std::setw(9) << "last" << std::setw(9) << "avg" << std::setw(9) << "peak" << "\n";
+
+    auto countRow = [&text](const char* label, size_t lastValue, size_t averageValue, size_t peakValue)
+        {
+            text << std::left << std::setw(14) << label << std::right
+                << std::setw(9) << lastValue << std::setw(9) << averageValue << std::setw(9) << peakValue << "\n";
+        };
+
+    auto timeRow = [&text](const char* label, double lastValue, double averageValue, double peakValue)
+        {
+            text << std::left << std::setw(14) << label << std::right << std::fixed << std::setprecision(3)
+                << std::setw(9) << lastValue << std::setw(9) << averageValue << std::setw(9) << peakValue << "\n";
+        };
+
+    countRow("hitboxes", last.hitboxes, average.hitboxes, peak.hitboxes);
+    countRow("resting", last.resting, average.resting, peak.resting);
+    countRow("candidates", last.candidates, average.candidates, peak.candidates);
+    countRow("narrow tests", last.narrowTests, average.narrowTests, peak.narrowTests);
+    countRow("contacts", last.contacts, average.contacts, peak.contacts);
+    countRow("enters", last.enters, average.enters, peak.enters);
+    countRow("exits", last.exits, average.exits, peak.exits);
+    timeRow("gather ms", last.gatherMs, average.gatherMs, peak.gatherMs);
+    timeRow("broadphase ms", last.broadphaseMs, average.broadphaseMs, peak.broadphaseMs);
+    timeRow("narrow ms", last.narrowMs, average.narrowMs, peak.narrowMs);
+    timeRow("dispatch ms", last.dispatchMs, average.dispatchMs, peak.dispatchMs);
+    timeRow("total ms", last.totalMs(), average.totalMs(), peak.peakTotalMs);
+
+    const SpriteBatch& sprite_batch = SpriteBatch::getInstance();
+    text << std::left << std::setw(14) << "sprite draws" << std::right
+        << std::setw(9) << sprite_batch.getDrawCallCount() << " for " << sprite_batch.getQuadCount() << " sprites\n";
+
+    if (AllocationCounter::isEnabled() && m_framesSinceRefresh > 0)
+    {
+        text << std::left << std::setw(14) << "heap allocs" << std::right << std::fixed << std::setprecision(1)
+            << std::setw(9) << static_cast<double>(allocations) / m_framesSinceRefresh << " per frame\n";
+    }
+    text << "F3 hide, F4 dump CSV";
+
+    m_statsText.setString(text.str());
+
+    sf::FloatRect bounds = m_statsText.getLocalBounds();
+    m_background.setSize(sf::Vector2f(bounds.left + bounds.width + 12.f, bounds.top + bounds.height + 12.f));
+
+    m_framesSinceRefresh = 0;
+    m_allocationsAtRefresh = AllocationCounter::getAllocationCount();
+}